@@ -0,0 +1,88 @@
+#include "knapsacksolver/algorithm_formatter.hpp"
+#include "knapsacksolver/instance_builder.hpp"
+#include "knapsacksolver/algorithms/dynamic_programming_primal_dual.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <sstream>
+
+using namespace knapsacksolver;
+
+namespace
+{
+
+const Instance build_instance(ItemId number_of_items)
+{
+    std::mt19937_64 generator(0);
+    std::uniform_int_distribution<Weight> distribution(1, 1000);
+    InstanceBuilder instance_builder;
+    instance_builder.set_capacity(1000 * number_of_items / 4);
+    for (ItemId item_id = 0; item_id < number_of_items; ++item_id) {
+        Profit profit = distribution(generator);
+        Weight weight = distribution(generator);
+        instance_builder.add_item(profit, weight);
+    }
+    return instance_builder.build();
+}
+
+/**
+ * Update the value of the output with a comment built with a string stream at
+ * each call, as the algorithms used to do.
+ */
+void BM_UpdateValueStringStream(benchmark::State& state)
+{
+    const Instance instance = build_instance(100);
+    Parameters parameters;
+    parameters.verbosity_level = 0;
+    for (auto _: state) {
+        Output output(instance);
+        AlgorithmFormatter algorithm_formatter(parameters, output);
+        for (Counter iteration = 0; iteration < 1000; ++iteration) {
+            std::stringstream ss;
+            ss << "it " << iteration << " (value)";
+            algorithm_formatter.update_value(iteration + 1, ss.str());
+        }
+        benchmark::DoNotOptimize(output.value);
+    }
+    state.SetItemsProcessed(state.iterations() * 1000);
+}
+
+/**
+ * Update the value of the output with a comment only built if it is printed.
+ */
+void BM_UpdateValueLazy(benchmark::State& state)
+{
+    const Instance instance = build_instance(100);
+    Parameters parameters;
+    parameters.verbosity_level = 0;
+    for (auto _: state) {
+        Output output(instance);
+        AlgorithmFormatter algorithm_formatter(parameters, output);
+        for (Counter iteration = 0; iteration < 1000; ++iteration)
+            algorithm_formatter.update_value(iteration + 1, iteration, " (value)");
+        benchmark::DoNotOptimize(output.value);
+    }
+    state.SetItemsProcessed(state.iterations() * 1000);
+}
+
+/**
+ * Solve small instances silently.
+ */
+void BM_DynamicProgrammingPrimalDualSmall(benchmark::State& state)
+{
+    const Instance instance = build_instance(state.range(0));
+    DynamicProgrammingPrimalDualParameters parameters;
+    parameters.verbosity_level = 0;
+    for (auto _: state) {
+        auto output = dynamic_programming_primal_dual(instance, parameters);
+        benchmark::DoNotOptimize(output.value);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+}
+
+BENCHMARK(BM_UpdateValueStringStream);
+BENCHMARK(BM_UpdateValueLazy);
+BENCHMARK(BM_DynamicProgrammingPrimalDualSmall)->Arg(50)->Arg(200);
@@ -0,0 +1,370 @@
+#include "knapsacksolver/generator.hpp"
+#include "knapsacksolver/features.hpp"
+#include "knapsacksolver/performance_counters.hpp"
+#include "knapsacksolver/algorithms/upper_bound_dantzig.hpp"
+#include "knapsacksolver/algorithms/greedy.hpp"
+#include "knapsacksolver/algorithms/dynamic_programming_bellman.hpp"
+#include "knapsacksolver/algorithms/dynamic_programming_primal_dual.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdlib>
+
+using namespace knapsacksolver;
+
+namespace
+{
+
+using Algorithm = std::function<Output(const Instance&)>;
+
+/**
+ * Generate an instance of a given class.
+ *
+ * The instance only depends on its class, its number of items, its maximum
+ * weight and its capacity ratio, so that the results are comparable across
+ * commits.
+ */
+const Instance generate_instance(
+        const std::string& instance_class,
+        ItemPos number_of_items,
+        Weight maximum_weight,
+        double capacity_ratio)
+{
+    std::mt19937_64 generator(0);
+    if (instance_class == "u") {
+        return generate_u(
+                number_of_items,
+                maximum_weight,
+                maximum_weight,
+                capacity_ratio,
+                generator);
+    } else if (instance_class == "wc") {
+        return generate_wc(
+                number_of_items,
+                maximum_weight,
+                capacity_ratio,
+                generator);
+    } else if (instance_class == "sc") {
+        return generate_sc(
+                number_of_items,
+                maximum_weight,
+                capacity_ratio,
+                generator);
+    } else if (instance_class == "ss") {
+        return generate_ss(
+                number_of_items,
+                maximum_weight,
+                capacity_ratio,
+                generator);
+    }
+    throw std::invalid_argument(
+            "Unknown instance class \"" + instance_class + "\".");
+}
+
+/**
+ * Return 'true' iff the hardware performance counters are read, which is
+ * enabled by setting the environment variable
+ * 'KNAPSACKSOLVER_PERFORMANCE_COUNTERS'.
+ *
+ * The algorithms then collect their statistics, which provide the number of
+ * states processed.
+ */
+bool performance_counters_enabled()
+{
+    static const bool enabled
+        = (std::getenv("KNAPSACKSOLVER_PERFORMANCE_COUNTERS") != nullptr);
+    return enabled;
+}
+
+/**
+ * Report the hardware performance counters per iteration and per state
+ * processed.
+ */
+void report_performance_counters(
+        benchmark::State& state,
+        const PerformanceCounterValues& values,
+        Counter number_of_states_processed)
+{
+    if (values.cycles >= 0)
+        state.counters["Cycles"] = benchmark::Counter(values.cycles, benchmark::Counter::kAvgIterations);
+    if (values.instructions >= 0)
+        state.counters["Instructions"] = benchmark::Counter(values.instructions, benchmark::Counter::kAvgIterations);
+    if (values.instructions_per_cycle() >= 0)
+        state.counters["IPC"] = values.instructions_per_cycle();
+    if (values.cache_misses >= 0)
+        state.counters["CacheMisses"] = benchmark::Counter(values.cache_misses, benchmark::Counter::kAvgIterations);
+    if (values.branch_misses >= 0)
+        state.counters["BranchMisses"] = benchmark::Counter(values.branch_misses, benchmark::Counter::kAvgIterations);
+    if (number_of_states_processed <= 0)
+        return;
+    state.counters["States"] = benchmark::Counter(number_of_states_processed, benchmark::Counter::kAvgIterations);
+    if (values.cycles >= 0)
+        state.counters["CyclesPerState"] = (double)values.cycles / number_of_states_processed;
+    if (values.cache_misses >= 0)
+        state.counters["CacheMissesPerState"] = (double)values.cache_misses / number_of_states_processed;
+    if (values.branch_misses >= 0)
+        state.counters["BranchMissesPerState"] = (double)values.branch_misses / number_of_states_processed;
+}
+
+/**
+ * Solve an instance of a given class.
+ *
+ * The arguments of the benchmark are the number of items, the maximum weight
+ * of the items and the capacity of the knapsack as a percentage of the total
+ * weight of the items.
+ */
+void BM_Algorithm(
+        benchmark::State& state,
+        const Algorithm& algorithm,
+        const std::string& instance_class)
+{
+    const Instance instance = generate_instance(
+            instance_class,
+            state.range(0),
+            state.range(1),
+            state.range(2) / 100.0);
+    Profit value = 0;
+    Profit bound = 0;
+    std::unique_ptr<PerformanceCounters> performance_counters;
+    PerformanceCounterValues performance_counters_start;
+    if (performance_counters_enabled()) {
+        performance_counters.reset(new PerformanceCounters());
+        performance_counters_start = performance_counters->read();
+    }
+    Counter number_of_states_processed = 0;
+    for (auto _: state) {
+        auto output = algorithm(instance);
+        value = output.value;
+        bound = output.bound;
+        number_of_states_processed += output.statistics.number_of_states_processed;
+        benchmark::DoNotOptimize(value);
+    }
+    if (performance_counters != nullptr && performance_counters->available()) {
+        report_performance_counters(
+                state,
+                performance_counters->read() - performance_counters_start,
+                number_of_states_processed);
+    }
+    // The value and the bound are reported to detect changes of behavior.
+    state.counters["Capacity"] = instance.capacity();
+    state.counters["Value"] = value;
+    state.counters["Bound"] = bound;
+}
+
+template <typename AlgorithmParameters>
+AlgorithmParameters silent_parameters()
+{
+    AlgorithmParameters parameters;
+    parameters.verbosity_level = 0;
+    parameters.statistics = performance_counters_enabled();
+    return parameters;
+}
+
+struct AlgorithmBenchmark
+{
+    /** Name of the algorithm. */
+    std::string name;
+
+    /** Algorithm. */
+    Algorithm algorithm;
+
+    /** Number of items and maximum weight of the benchmarked instances. */
+    std::vector<std::vector<int64_t>> sizes;
+};
+
+/**
+ * Register a benchmark for each algorithm of the main executable and each
+ * instance class.
+ *
+ * The sizes depend on the complexity of the algorithms, for example the
+ * algorithms storing all the states of the dynamic program are only run on
+ * small instances.
+ */
+int register_algorithm_benchmarks()
+{
+    std::vector<std::vector<int64_t>> sizes_small = {{100, 100}, {100, 1000}};
+    std::vector<std::vector<int64_t>> sizes_medium = {{200, 1000}, {1000, 1000}};
+    std::vector<std::vector<int64_t>> sizes_large = {{1000, 1000}, {10000, 1000}, {10000, 10000}};
+    // Capacity ratios in percent. Tight capacities lead to few items in the
+    // solution while large ones lead to few items out of it.
+    std::vector<int64_t> capacity_ratios = {25, 50, 75};
+
+    std::vector<AlgorithmBenchmark> algorithm_benchmarks = {
+        {
+            "upper_bound_dantzig",
+            [](const Instance& instance)
+            {
+                return upper_bound_dantzig(
+                        instance,
+                        silent_parameters<UpperBoundDantzigParameters>());
+            },
+            sizes_large,
+        }, {
+            "greedy",
+            [](const Instance& instance)
+            {
+                return greedy(
+                        instance,
+                        silent_parameters<GreedyParameters>());
+            },
+            sizes_large,
+        }, {
+            "greedy_extended",
+            [](const Instance& instance)
+            {
+                auto parameters = silent_parameters<GreedyParameters>();
+                parameters.extended = true;
+                return greedy(instance, parameters);
+            },
+            sizes_large,
+        }, {
+            "dynamic_programming_bellman_rec",
+            [](const Instance& instance)
+            {
+                return dynamic_programming_bellman_rec(
+                        instance,
+                        silent_parameters<Parameters>());
+            },
+            sizes_small,
+        }, {
+            "dynamic_programming_bellman_array",
+            [](const Instance& instance)
+            {
+                return dynamic_programming_bellman_array(
+                        instance,
+                        silent_parameters<Parameters>());
+            },
+            sizes_medium,
+        }, {
+            "dynamic_programming_bellman_array_parallel",
+            [](const Instance& instance)
+            {
+                return dynamic_programming_bellman_array_parallel(
+                        instance,
+                        silent_parameters<Parameters>());
+            },
+            sizes_medium,
+        }, {
+            "dynamic_programming_bellman_array_all",
+            [](const Instance& instance)
+            {
+                return dynamic_programming_bellman_array_all(
+                        instance,
+                        silent_parameters<Parameters>());
+            },
+            sizes_small,
+        }, {
+            "dynamic_programming_bellman_array_disk",
+            [](const Instance& instance)
+            {
+                return dynamic_programming_bellman_array_disk(
+                        instance,
+                        silent_parameters<DynamicProgrammingBellmanArrayDiskParameters>());
+            },
+            sizes_medium,
+        }, {
+            "dynamic_programming_bellman_array_one",
+            [](const Instance& instance)
+            {
+                return dynamic_programming_bellman_array_one(
+                        instance,
+                        silent_parameters<DynamicProgrammingBellmanArrayOneParameters>());
+            },
+            sizes_small,
+        }, {
+            "dynamic_programming_bellman_array_part",
+            [](const Instance& instance)
+            {
+                return dynamic_programming_bellman_array_part(
+                        instance,
+                        silent_parameters<DynamicProgrammingBellmanArrayPartParameters>());
+            },
+            sizes_small,
+        }, {
+            "dynamic_programming_bellman_array_rec",
+            [](const Instance& instance)
+            {
+                return dynamic_programming_bellman_array_rec(
+                        instance,
+                        silent_parameters<Parameters>());
+            },
+            sizes_medium,
+        }, {
+            "dynamic_programming_bellman_list",
+            [](const Instance& instance)
+            {
+                return dynamic_programming_bellman_list(
+                        instance,
+                        silent_parameters<DynamicProgrammingBellmanListParameters>());
+            },
+            sizes_small,
+        }, {
+            "dynamic_programming_bellman_list_sort",
+            [](const Instance& instance)
+            {
+                auto parameters = silent_parameters<DynamicProgrammingBellmanListParameters>();
+                parameters.sort = true;
+                return dynamic_programming_bellman_list(instance, parameters);
+            },
+            sizes_medium,
+        }, {
+            "dynamic_programming_primal_dual",
+            [](const Instance& instance)
+            {
+                return dynamic_programming_primal_dual(
+                        instance,
+                        silent_parameters<DynamicProgrammingPrimalDualParameters>());
+            },
+            sizes_large,
+        }, {
+            "dynamic_programming_primal_dual_pairing",
+            [](const Instance& instance)
+            {
+                auto parameters = silent_parameters<DynamicProgrammingPrimalDualParameters>();
+                parameters.pairing = true;
+                return dynamic_programming_primal_dual(instance, parameters);
+            },
+            sizes_large,
+        }, {
+            "auto",
+            [](const Instance& instance) -> Output
+            {
+                AlgorithmSelection selection = select_algorithm(
+                        compute_features(instance));
+                if (selection.algorithm == "greedy") {
+                    return greedy(
+                            instance,
+                            silent_parameters<GreedyParameters>());
+                } else if (selection.algorithm == "dynamic-programming-bellman-array-rec") {
+                    return dynamic_programming_bellman_array_rec(
+                            instance,
+                            silent_parameters<Parameters>());
+                }
+                auto parameters = silent_parameters<DynamicProgrammingPrimalDualParameters>();
+                parameters.pairing = selection.pairing;
+                return dynamic_programming_primal_dual(instance, parameters);
+            },
+            sizes_large,
+        },
+    };
+
+    for (const AlgorithmBenchmark& algorithm_benchmark: algorithm_benchmarks) {
+        for (std::string instance_class: {"u", "wc", "sc", "ss"}) {
+            auto benchmark = benchmark::RegisterBenchmark(
+                    (algorithm_benchmark.name + "/" + instance_class).c_str(),
+                    BM_Algorithm,
+                    algorithm_benchmark.algorithm,
+                    instance_class);
+            benchmark->ArgNames({"n", "R", "C"});
+            benchmark->Unit(benchmark::kMillisecond);
+            for (const std::vector<int64_t>& size: algorithm_benchmark.sizes)
+                for (int64_t capacity_ratio: capacity_ratios)
+                    benchmark->Args({size[0], size[1], capacity_ratio});
+        }
+    }
+    return 0;
+}
+
+const int algorithm_benchmarks_registered = register_algorithm_benchmarks();
+
+}
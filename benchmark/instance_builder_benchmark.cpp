@@ -0,0 +1,137 @@
+#include "knapsacksolver/instance_builder.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdio>
+#include <fstream>
+#include <random>
+
+using namespace knapsacksolver;
+
+namespace
+{
+
+/**
+ * Get the path of an instance file with 'number_of_items' items in the given
+ * format.
+ *
+ * The file is generated the first time it is requested.
+ */
+std::string instance_path(
+        ItemId number_of_items,
+        const std::string& format)
+{
+    std::string path = "instance_builder_benchmark_"
+        + std::to_string(number_of_items) + "." + format;
+    if (std::ifstream(path).good())
+        return path;
+
+    std::mt19937_64 generator(0);
+    std::uniform_int_distribution<Weight> distribution(1, 1000000);
+    Weight capacity = 1000000 * number_of_items / 4;
+    std::ofstream file(path, std::ios::binary);
+    if (format == "pisinger") {
+        file << "benchmark" << "\n"
+            << "n " << number_of_items << "\n"
+            << "c " << capacity << "\n"
+            << "z 0" << "\n"
+            << "time 0.00" << "\n";
+        for (ItemId item_id = 0; item_id < number_of_items; ++item_id) {
+            Profit profit = distribution(generator);
+            Weight weight = distribution(generator);
+            file << item_id + 1 << "," << profit << "," << weight << ",0\n";
+        }
+        file << "-----\n";
+    } else {
+        InstanceBuilder instance_builder;
+        instance_builder.set_capacity(capacity);
+        for (ItemId item_id = 0; item_id < number_of_items; ++item_id) {
+            Profit profit = distribution(generator);
+            Weight weight = distribution(generator);
+            instance_builder.add_item(profit, weight);
+        }
+        const Instance instance = instance_builder.build();
+        file.close();
+        if (format == "binary") {
+            instance.write_binary(path);
+        } else {
+            instance.write(path);
+        }
+    }
+    return path;
+}
+
+void read(
+        benchmark::State& state,
+        const std::string& format)
+{
+    ItemId number_of_items = state.range(0);
+    std::string path = instance_path(number_of_items, format);
+    for (auto _: state) {
+        InstanceBuilder instance_builder;
+        instance_builder.read(path, format);
+        const Instance instance = instance_builder.build();
+        benchmark::DoNotOptimize(instance.total_item_profit());
+    }
+    state.SetItemsProcessed(state.iterations() * number_of_items);
+}
+
+/**
+ * Reference reader for the 'standard' format, based on 'std::ifstream'
+ * extraction operators.
+ */
+void BM_ReadStandardIfstream(benchmark::State& state)
+{
+    ItemId number_of_items = state.range(0);
+    std::string path = instance_path(number_of_items, "standard");
+    for (auto _: state) {
+        std::ifstream file(path);
+        InstanceBuilder instance_builder;
+        ItemId n;
+        Weight capacity;
+        file >> n >> capacity;
+        instance_builder.set_capacity(capacity);
+        Profit profit;
+        Weight weight;
+        for (ItemId item_id = 0; item_id < n; ++item_id) {
+            file >> profit >> weight;
+            instance_builder.add_item(profit, weight);
+        }
+        const Instance instance = instance_builder.build();
+        benchmark::DoNotOptimize(instance.total_item_profit());
+    }
+    state.SetItemsProcessed(state.iterations() * number_of_items);
+}
+
+void BM_Build(benchmark::State& state)
+{
+    ItemId number_of_items = state.range(0);
+    std::mt19937_64 generator(0);
+    std::uniform_int_distribution<Weight> distribution(1, 1000000);
+    std::vector<Profit> profits(number_of_items);
+    std::vector<Weight> weights(number_of_items);
+    for (ItemId item_id = 0; item_id < number_of_items; ++item_id) {
+        profits[item_id] = distribution(generator);
+        weights[item_id] = distribution(generator);
+    }
+    for (auto _: state) {
+        InstanceBuilder instance_builder;
+        instance_builder.set_capacity(1000000 * number_of_items / 4);
+        instance_builder.add_items(profits.data(), weights.data(), number_of_items);
+        const Instance instance = instance_builder.build();
+        benchmark::DoNotOptimize(instance.total_item_profit());
+    }
+    state.SetItemsProcessed(state.iterations() * number_of_items);
+}
+
+void BM_ReadStandard(benchmark::State& state) { read(state, "standard"); }
+void BM_ReadPisinger(benchmark::State& state) { read(state, "pisinger"); }
+void BM_ReadBinary(benchmark::State& state) { read(state, "binary"); }
+
+}
+
+BENCHMARK(BM_Build)->Arg(1000000)->Arg(10000000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ReadStandardIfstream)->Arg(1000000)->Arg(10000000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ReadStandard)->Arg(1000000)->Arg(10000000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ReadPisinger)->Arg(1000000)->Arg(10000000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ReadBinary)->Arg(1000000)->Arg(10000000)->Unit(benchmark::kMillisecond);
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "knapsacksolver/solution.hpp"
+#include "knapsacksolver/performance_counters.hpp"
 
 namespace knapsacksolver
 {
@@ -16,7 +17,7 @@ public:
             Output& output):
         parameters_(parameters),
         output_(output),
-        os_(parameters.create_os()) { }
+        os_((parameters.verbosity_level > 0)? parameters.create_os(): nullptr) { }
 
     /** Print the header. */
     void start(
@@ -44,20 +45,69 @@ public:
             Weight bound_new,
             const std::string& s);
 
+    /**
+     * Update the solution value.
+     *
+     * The comment "it <iteration><suffix>" is only built if it is printed, so
+     * that this method can be called from the hot loops of the algorithms.
+     */
+    void update_value(
+            Weight value_new,
+            Counter iteration,
+            const char* suffix = "");
+
+    /**
+     * Update the bound.
+     *
+     * The comment "it <iteration><suffix>" is only built if it is printed.
+     */
+    void update_bound(
+            Weight bound_new,
+            Counter iteration,
+            const char* suffix = "");
+
+    /**
+     * Raise the value to the lower bound shared with the algorithms running
+     * concurrently.
+     */
+    void update_shared_lower_bound();
+
+    /**
+     * End the current phase of the algorithm and start a new one.
+     *
+     * Only used if the statistics are collected. The hardware performance
+     * counters, if they are read, are attributed to the phase.
+     */
+    void start_phase(const std::string& name);
+
     /** Method to call at the end of the algorithm. */
     void end();
 
 private:
 
+    /** Build the comment of an iteration. */
+    std::string iteration_comment(
+            Counter iteration,
+            const char* suffix) const;
+
     /** Parameters. */
     const Parameters& parameters_;
 
     /** Output. */
     Output& output_;
 
-    /** Output stream. */
+    /** Output stream, only created if the verbosity level is not 0. */
     std::unique_ptr<optimizationtools::ComposeStream> os_;
 
+    /**
+     * Hardware performance counters, only created if they are requested and
+     * available.
+     */
+    std::unique_ptr<PerformanceCounters> performance_counters_;
+
+    /** Values of the hardware performance counters at the start. */
+    PerformanceCounterValues performance_counters_start_;
+
 };
 
 }
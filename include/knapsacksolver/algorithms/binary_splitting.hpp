@@ -0,0 +1,104 @@
+#pragma once
+
+#include "knapsacksolver/bounded_instance.hpp"
+#include "knapsacksolver/solution.hpp"
+
+#include <functional>
+
+namespace knapsacksolver
+{
+
+struct BinarySplittingParameters: Parameters
+{
+    /**
+     * Algorithm used to solve the 0-1 knapsack instance.
+     *
+     * If not set, 'dynamic_programming_primal_dual' is used.
+     */
+    std::function<Output(const Instance&, const Parameters&)> algorithm = nullptr;
+
+
+    virtual int format_width() const override { return 37; }
+
+    virtual void format(std::ostream& os) const override
+    {
+        Parameters::format(os);
+        int width = format_width();
+        os
+            << std::setw(width) << std::left << "Has algorithm: " << (algorithm != nullptr) << std::endl
+            ;
+    }
+
+    virtual nlohmann::json to_json() const override
+    {
+        nlohmann::json json = Parameters::to_json();
+        json.merge_patch({
+                {"HasAlgorithm", (algorithm != nullptr)}});
+        return json;
+    }
+};
+
+struct BinarySplittingOutput
+{
+    BinarySplittingOutput(
+            const BoundedInstance& instance):
+        number_of_copies(instance.number_of_items(), 0) { }
+
+
+    /**
+     * Value of the selected copies.
+     *
+     * If 'parameters.lower_bound' is optimal, no better solution might be
+     * found; then, it might be smaller than the lower bound.
+     */
+    Profit value = 0;
+
+    /** Bound. */
+    Profit bound = std::numeric_limits<Profit>::max();
+
+    /** Number of selected copies of each item. */
+    std::vector<ItemId> number_of_copies;
+
+    /** Weight of the solution. */
+    Weight weight = 0;
+
+    /** Number of items of the 0-1 knapsack instance. */
+    ItemId number_of_binary_items = 0;
+
+    /** Elapsed time. */
+    double time = 0.0;
+
+    /** Statistics of the algorithm solving the 0-1 knapsack instance. */
+    Statistics statistics;
+
+
+    nlohmann::json to_json() const
+    {
+        nlohmann::json json {
+            {"Value", value},
+            {"Bound", bound},
+            {"Weight", weight},
+            {"NumberOfCopies", number_of_copies},
+            {"NumberOfBinaryItems", number_of_binary_items},
+            {"Time", time}};
+        if (statistics.enabled)
+            json["Statistics"] = statistics.to_json();
+        return json;
+    }
+};
+
+/**
+ * Solve a bounded knapsack problem by splitting each item into 0-1 items.
+ *
+ * An item with 'c' copies is split into items containing 1, 2, 4, ...,
+ * 2^(k-1) copies and a last item containing the remaining copies. Any number
+ * of copies between 0 and 'c' can be obtained by combining these items, so
+ * the 0-1 knapsack instance has 'O(sum log c)' items instead of 'sum c'.
+ * Beforehand, the number of copies of each item is reduced to the number of
+ * copies which fit in the knapsack.
+ */
+const BinarySplittingOutput binary_splitting(
+        const BoundedInstance& instance,
+        const BinarySplittingParameters& parameters = {});
+
+}
@@ -15,6 +15,97 @@ Output dynamic_programming_bellman_array(
         const Parameters& parameters = {});
 
 
+struct DynamicProgrammingBellmanArrayCapacitiesParameters: Parameters
+{
+    /**
+     * Capacities for which the optimal values are computed.
+     *
+     * They must be between 0 and the capacity of the instance.
+     */
+    std::vector<Weight> capacities;
+
+    /** Retrieve an optimal solution for each capacity. */
+    bool solutions = false;
+
+
+    virtual int format_width() const override { return 37; }
+
+    virtual void format(std::ostream& os) const override
+    {
+        Parameters::format(os);
+        int width = format_width();
+        os
+            << std::setw(width) << std::left << "Number of capacities: " << capacities.size() << std::endl
+            << std::setw(width) << std::left << "Solutions: " << solutions << std::endl
+            ;
+    }
+
+    virtual nlohmann::json to_json() const override
+    {
+        nlohmann::json json = Parameters::to_json();
+        json.merge_patch({
+                {"NumberOfCapacities", capacities.size()},
+                {"Solutions", solutions}});
+        return json;
+    }
+};
+
+struct DynamicProgrammingBellmanArrayCapacitiesOutput: Output
+{
+    DynamicProgrammingBellmanArrayCapacitiesOutput(
+            const Instance& instance):
+        Output(instance) { }
+
+
+    /**
+     * Optimal value for each capacity.
+     *
+     * 'values[i]' is the optimal value for 'parameters.capacities[i]'. It is
+     * always filled, even if the algorithm is interrupted; in this case, it
+     * is the optimal value using only the items processed, which is a lower
+     * bound.
+     */
+    std::vector<Profit> values;
+
+    /**
+     * Optimal solution for each capacity.
+     *
+     * Only filled if 'parameters.solutions' is 'true'. If the algorithm is
+     * interrupted, the solutions only contain items processed.
+     */
+    std::vector<Solution> solutions;
+
+
+    virtual void format(std::ostream& os) const override
+    {
+        Output::format(os);
+        int width = format_width();
+        os
+            << std::setw(width) << std::left << "Number of capacities: " << values.size() << std::endl
+            ;
+    }
+
+    virtual nlohmann::json to_json() const override
+    {
+        nlohmann::json json = Output::to_json();
+        json.merge_patch({
+                {"Values", values}});
+        return json;
+    }
+};
+
+/**
+ * Compute the optimal values of the instance for several capacities with a
+ * single sweep of the Bellman array dynamic programming algorithm.
+ *
+ * The value and the bound of the output refer to the capacity of the
+ * instance; they are only set if it belongs to the requested capacities.
+ */
+const DynamicProgrammingBellmanArrayCapacitiesOutput dynamic_programming_bellman_array_capacities(
+        const Instance& instance,
+        const DynamicProgrammingBellmanArrayCapacitiesParameters& parameters);
+
+
 Output dynamic_programming_bellman_array_parallel(
         const Instance& instance,
         const Parameters& parameters = {});
@@ -25,6 +116,125 @@ Output dynamic_programming_bellman_array_all(
         const Parameters& parameters = {});
 
 
+struct DynamicProgrammingBellmanArrayDiskParameters: Parameters
+{
+    /**
+     * Directory of the file storing the decisions.
+     *
+     * A new file with a unique name is created in this directory, so that no
+     * existing file is overwritten, and it is removed at the end. If empty,
+     * an anonymous temporary file is created in the temporary directory of
+     * the system.
+     */
+    std::string decision_directory = "";
+
+
+    virtual int format_width() const override { return 37; }
+
+    virtual void format(std::ostream& os) const override
+    {
+        Parameters::format(os);
+        int width = format_width();
+        os
+            << std::setw(width) << std::left << "Decision directory: " << decision_directory << std::endl
+            ;
+    }
+
+    virtual nlohmann::json to_json() const override
+    {
+        nlohmann::json json = Parameters::to_json();
+        json.merge_patch({
+                {"DecisionDirectory", decision_directory}});
+        return json;
+    }
+};
+
+struct DynamicProgrammingBellmanArrayDiskOutput: Output
+{
+    DynamicProgrammingBellmanArrayDiskOutput(
+            const Instance& instance):
+        Output(instance) { }
+
+
+    /** Size of the decision file, in bytes. */
+    Counter decision_file_size = 0;
+
+
+    virtual void format(std::ostream& os) const override
+    {
+        Output::format(os);
+        int width = format_width();
+        os
+            << std::setw(width) << std::left << "Decision file size: " << decision_file_size << std::endl
+            ;
+    }
+
+    virtual nlohmann::json to_json() const override
+    {
+        nlohmann::json json = Output::to_json();
+        json.merge_patch({
+                {"DecisionFileSize", decision_file_size}});
+        return json;
+    }
+};
+
+/**
+ * Bellman array dynamic programming algorithm storing its decisions on disk.
+ *
+ * A single row of values is kept in memory. After each item, the bitset of
+ * the capacities for which the item improves the value is appended to a file
+ * with one large sequential write. The solution is then retrieved by reading
+ * one word per item, from the last item to the first one.
+ *
+ * It uses O(C) memory and O(nC / 8) bytes of disk.
+ */
+const DynamicProgrammingBellmanArrayDiskOutput dynamic_programming_bellman_array_disk(
+        const Instance& instance,
+        const DynamicProgrammingBellmanArrayDiskParameters& parameters = {});
+
+
+struct DynamicProgrammingBellmanArrayOneParameters: Parameters
+{
+    /**
+     * Path of the checkpoint file.
+     *
+     * If set, the current item and the row of values are written to this
+     * file every 'checkpoint_interval' seconds and when the algorithm is
+     * interrupted.
+     */
+    std::string checkpoint_path = "";
+
+    /** Minimum time between two checkpoints, in seconds. */
+    double checkpoint_interval = 60;
+
+    /** Resume from the checkpoint file if it exists. */
+    bool resume = false;
+
+
+    virtual int format_width() const override { return 37; }
+
+    virtual void format(std::ostream& os) const override
+    {
+        Parameters::format(os);
+        int width = format_width();
+        os
+            << std::setw(width) << std::left << "Checkpoint path: " << checkpoint_path << std::endl
+            << std::setw(width) << std::left << "Checkpoint interval: " << checkpoint_interval << std::endl
+            << std::setw(width) << std::left << "Resume: " << resume << std::endl
+            ;
+    }
+
+    virtual nlohmann::json to_json() const override
+    {
+        nlohmann::json json = Parameters::to_json();
+        json.merge_patch({
+                {"CheckpointPath", checkpoint_path},
+                {"CheckpointInterval", checkpoint_interval},
+                {"Resume", resume}});
+        return json;
+    }
+};
+
 struct DynamicProgrammingBellmanArrayOneOutput: Output
 {
     DynamicProgrammingBellmanArrayOneOutput(
@@ -56,7 +266,7 @@ struct DynamicProgrammingBellmanArrayOneOutput: Output
 
 const DynamicProgrammingBellmanArrayOneOutput dynamic_programming_bellman_array_one(
         const Instance& instance,
-        const Parameters& parameters = {});
+        const DynamicProgrammingBellmanArrayOneParameters& parameters = {});
 
 
 struct DynamicProgrammingBellmanArrayPartParameters: Parameters
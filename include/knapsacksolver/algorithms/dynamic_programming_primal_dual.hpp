@@ -2,9 +2,36 @@
 
 #include "knapsacksolver/solution.hpp"
 
+#include <memory>
+
 namespace knapsacksolver
 {
 
+struct DynamicProgrammingPrimalDualWorkspaceData;
+
+/**
+ * Memory of the primal-dual dynamic programming algorithm kept between calls.
+ *
+ * Solving many instances in a row with the same workspace avoids reallocating
+ * the lists of states at each call. A workspace must not be used by several
+ * calls at the same time.
+ */
+class DynamicProgrammingPrimalDualWorkspace
+{
+
+public:
+
+    /** Constructor. */
+    DynamicProgrammingPrimalDualWorkspace();
+
+    /** Destructor. */
+    ~DynamicProgrammingPrimalDualWorkspace();
+
+    /** Data. */
+    std::unique_ptr<DynamicProgrammingPrimalDualWorkspaceData> data;
+
+};
+
 struct DynamicProgrammingPrimalDualParameters: Parameters
 {
     bool greedy = true;
@@ -13,6 +40,28 @@ struct DynamicProgrammingPrimalDualParameters: Parameters
 
     ItemId partial_solution_size = 64;
 
+    /** Workspace; if 'nullptr', the memory is allocated at each call. */
+    DynamicProgrammingPrimalDualWorkspace* workspace = nullptr;
+
+    /**
+     * Path of the checkpoint file.
+     *
+     * If set, the state of the algorithm is written to this file every
+     * 'checkpoint_interval' seconds and when the algorithm is interrupted.
+     */
+    std::string checkpoint_path = "";
+
+    /** Minimum time between two checkpoints, in seconds. */
+    double checkpoint_interval = 60;
+
+    /**
+     * Resume from the checkpoint file if it exists.
+     *
+     * The checkpoint must have been written for the same instance and with
+     * the same partial solution size.
+     */
+    bool resume = false;
+
 
     virtual int format_width() const override { return 37; }
 
@@ -24,6 +73,9 @@ struct DynamicProgrammingPrimalDualParameters: Parameters
             << std::setw(width) << std::left << "Greedy: " << greedy << std::endl
             << std::setw(width) << std::left << "Pairing: " << pairing << std::endl
             << std::setw(width) << std::left << "Partial solution size: " << partial_solution_size << std::endl
+            << std::setw(width) << std::left << "Checkpoint path: " << checkpoint_path << std::endl
+            << std::setw(width) << std::left << "Checkpoint interval: " << checkpoint_interval << std::endl
+            << std::setw(width) << std::left << "Resume: " << resume << std::endl
             ;
     }
 
@@ -33,7 +85,10 @@ struct DynamicProgrammingPrimalDualParameters: Parameters
         json.merge_patch({
                 {"Greedy", greedy},
                 {"Pairing", pairing},
-                {"PartialSolutionSize", partial_solution_size}});
+                {"PartialSolutionSize", partial_solution_size},
+                {"CheckpointPath", checkpoint_path},
+                {"CheckpointInterval", checkpoint_interval},
+                {"Resume", resume}});
         return json;
     }
 };
@@ -70,4 +125,125 @@ const DynamicProgrammingPrimalDualOutput dynamic_programming_primal_dual(
         const Instance& instance,
         const DynamicProgrammingPrimalDualParameters& parameters = {});
 
+/**
+ * Session to solve a sequence of slightly different instances with the
+ * primal-dual dynamic programming algorithm.
+ *
+ * The session keeps the items, the capacity and the last solution. After
+ * items have been added, removed or modified, or after the capacity has been
+ * changed, the last solution is repaired and used as initial solution of the
+ * next solve.
+ *
+ * Item ids of the session are stable: removing an item doesn't change the id
+ * of the other items.
+ */
+class DynamicProgrammingPrimalDualSession
+{
+
+public:
+
+    /** Constructor. */
+    DynamicProgrammingPrimalDualSession() { }
+
+    /** Add an item and return its id. */
+    ItemId add_item(
+            Profit profit,
+            Weight weight);
+
+    /** Remove an item. */
+    void remove_item(ItemId item_id);
+
+    /** Modify the profit and the weight of an item. */
+    void set_item(
+            ItemId item_id,
+            Profit profit,
+            Weight weight);
+
+    /** Set the capacity of the knapsack. */
+    void set_capacity(Weight capacity);
+
+    /**
+     * Solve the current instance.
+     *
+     * If the instance hasn't been modified since the last call, the last
+     * output is returned directly.
+     */
+    const DynamicProgrammingPrimalDualOutput& solve(
+            const DynamicProgrammingPrimalDualParameters& parameters = {});
+
+    /*
+     * Getters
+     */
+
+    /** Get the number of items of the session, including removed items. */
+    ItemId number_of_items() const { return items_.size(); }
+
+    /** Get the capacity. */
+    Weight capacity() const { return capacity_; }
+
+    /** Return 'true' iff item 'item_id' has been removed. */
+    bool removed(ItemId item_id) const { return items_[item_id].removed; }
+
+    /** Return 'true' iff item 'item_id' is in the last solution. */
+    bool contains(ItemId item_id) const { return items_[item_id].contained; }
+
+    /**
+     * Get the last solved instance.
+     *
+     * Only items that are not removed and that fit in the knapsack belong to
+     * it.
+     */
+    const Instance& instance() const { return *instance_; }
+
+    /** Get the id in the session of an item of the last solved instance. */
+    ItemId session_item_id(ItemId item_id) const { return instance2session_[item_id]; }
+
+private:
+
+    /*
+     * Private methods
+     */
+
+    /** Check that an item id is valid. */
+    void check_item_id(ItemId item_id) const;
+
+    /*
+     * Private attributes
+     */
+
+    struct SessionItem
+    {
+        /** Profit of the item. */
+        Profit profit;
+
+        /** Weight of the item. */
+        Weight weight;
+
+        /** 'true' iff the item has been removed. */
+        bool removed = false;
+
+        /** 'true' iff the item is in the last solution. */
+        bool contained = false;
+    };
+
+    /** Items. */
+    std::vector<SessionItem> items_;
+
+    /** Capacity. */
+    Weight capacity_ = 0;
+
+    /** 'true' iff the instance has been modified since the last solve. */
+    bool modified_ = true;
+
+    /** Last solved instance. */
+    std::unique_ptr<Instance> instance_;
+
+    /** For each item of the last solved instance, its id in the session. */
+    std::vector<ItemId> instance2session_;
+
+    /** Output of the last solve. */
+    std::unique_ptr<DynamicProgrammingPrimalDualOutput> output_;
+
+};
+
 }
@@ -19,6 +19,16 @@ struct GreedyParameters: Parameters
     /** Partial sort. */
     PartialSort* partial_sort = nullptr;
 
+    /**
+     * Extended greedy.
+     *
+     * In addition to the forward and backward solutions, fill the break
+     * solution with all the following items which fit, and add the break item
+     * to the break solution, remove the least efficient items until it fits,
+     * and fill it again. It remains linear in the number of items.
+     */
+    bool extended = false;
+
 
     virtual int format_width() const override { return 37; }
 
@@ -29,6 +39,7 @@ struct GreedyParameters: Parameters
         os
             << std::setw(width) << std::left << "Has full sort: " << (full_sort != nullptr) << std::endl
             << std::setw(width) << std::left << "Has partial sort: " << (partial_sort != nullptr) << std::endl
+            << std::setw(width) << std::left << "Extended: " << extended << std::endl
             ;
     }
 
@@ -37,7 +48,8 @@ struct GreedyParameters: Parameters
         nlohmann::json json = Parameters::to_json();
         json.merge_patch({
                 {"HasFullSort", (full_sort != nullptr)},
-                {"HasPartialSort", (partial_sort != nullptr)}});
+                {"HasPartialSort", (partial_sort != nullptr)},
+                {"Extended", extended}});
         return json;
     }
 };
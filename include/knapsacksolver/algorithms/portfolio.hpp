@@ -0,0 +1,129 @@
+#pragma once
+
+#include "knapsacksolver/solution.hpp"
+
+#include <functional>
+
+namespace knapsacksolver
+{
+
+/**
+ * Algorithm of a portfolio.
+ *
+ * The parameters given to the algorithm contain the timer, the stop flag, the
+ * shared lower bound and the new solution callback of the portfolio. They
+ * must be forwarded to the parameters of the algorithm, for example with
+ * 'portfolio_algorithm_parameters'.
+ */
+struct PortfolioAlgorithm
+{
+    /** Name of the algorithm. */
+    std::string name;
+
+    /** Algorithm. */
+    std::function<Output(const Instance&, const Parameters&)> algorithm;
+};
+
+struct PortfolioParameters: Parameters
+{
+    /**
+     * Algorithms run concurrently, each one in its own thread.
+     *
+     * If empty, the primal-dual dynamic programming algorithm with and
+     * without pairing, and the partial-solution Bellman array algorithm if
+     * the capacity is not greater than 'maximum_array_capacity', are run.
+     */
+    std::vector<PortfolioAlgorithm> algorithms;
+
+    /**
+     * Maximum capacity for which the Bellman array algorithm is part of the
+     * default portfolio.
+     */
+    Weight maximum_array_capacity = 10000000;
+
+
+    virtual int format_width() const override { return 37; }
+
+    virtual void format(std::ostream& os) const override
+    {
+        Parameters::format(os);
+        int width = format_width();
+        os
+            << std::setw(width) << std::left << "Number of algorithms: " << algorithms.size() << std::endl
+            << std::setw(width) << std::left << "Maximum array capacity: " << maximum_array_capacity << std::endl
+            ;
+    }
+
+    virtual nlohmann::json to_json() const override
+    {
+        nlohmann::json json = Parameters::to_json();
+        json.merge_patch({
+                {"NumberOfAlgorithms", algorithms.size()},
+                {"MaximumArrayCapacity", maximum_array_capacity}});
+        return json;
+    }
+};
+
+struct PortfolioOutput: Output
+{
+    PortfolioOutput(
+            const Instance& instance):
+        Output(instance) { }
+
+
+    /**
+     * Name of the algorithm which completed the proof of optimality.
+     *
+     * Empty if the optimality hasn't been proven.
+     */
+    std::string winner;
+
+
+    virtual void format(std::ostream& os) const override
+    {
+        Output::format(os);
+        int width = format_width();
+        os
+            << std::setw(width) << std::left << "Winner: " << winner << std::endl
+            ;
+    }
+
+    virtual nlohmann::json to_json() const override
+    {
+        nlohmann::json json = Output::to_json();
+        json.merge_patch({
+                {"Winner", winner}});
+        return json;
+    }
+};
+
+/**
+ * Get the parameters of an algorithm of a portfolio from the parameters given
+ * by the portfolio.
+ */
+template <typename AlgorithmParameters>
+AlgorithmParameters portfolio_algorithm_parameters(
+        const Parameters& parameters)
+{
+    AlgorithmParameters algorithm_parameters;
+    algorithm_parameters.timer = parameters.timer;
+    algorithm_parameters.verbosity_level = 0;
+    algorithm_parameters.stop = parameters.stop;
+    algorithm_parameters.shared_lower_bound = parameters.shared_lower_bound;
+    algorithm_parameters.new_solution_callback = parameters.new_solution_callback;
+    algorithm_parameters.memory_limit = parameters.memory_limit;
+    return algorithm_parameters;
+}
+
+/**
+ * Run several algorithms concurrently.
+ *
+ * The algorithms share the value of the best solution found, which they use
+ * to prune, and they all stop as soon as the best solution found is proven
+ * optimal by the bound of one of them.
+ */
+const PortfolioOutput portfolio(
+        const Instance& instance,
+        const PortfolioParameters& parameters = {});
+
+}
@@ -0,0 +1,191 @@
+#pragma once
+
+#include "knapsacksolver/solution.hpp"
+
+#include <functional>
+
+namespace knapsacksolver
+{
+
+/** Instance of a batch. */
+struct BatchEntry
+{
+    /**
+     * Position of the instance in the batch.
+     *
+     * For a manifest, it counts the non-empty lines, including the ones which
+     * can't be read.
+     */
+    std::size_t position = 0;
+
+    /** Line of the instance in the manifest, starting from 1; 0 otherwise. */
+    Counter line_number = 0;
+
+    /**
+     * Name of the instance: its path, its name or "line <line number>" for a
+     * manifest; empty otherwise.
+     */
+    std::string name;
+};
+
+struct BatchParameters
+{
+    /**
+     * Number of threads.
+     *
+     * If 0, the number of concurrent threads supported by the hardware is
+     * used.
+     */
+    int number_of_threads = 1;
+
+    /** Time limit of each instance, in seconds; no limit if negative. */
+    double time_limit = -1;
+
+    /** Memory limit of each instance, in bytes; no limit if negative. */
+    Counter memory_limit = -1;
+
+    /**
+     * Algorithm used to solve each instance.
+     *
+     * It may be called concurrently from several threads. The parameters
+     * given to the algorithm contain the timer, started when the instance is
+     * taken, and the memory limit; they can be converted with
+     * 'portfolio_algorithm_parameters'.
+     *
+     * If not set, 'dynamic_programming_primal_dual' is used without any
+     * output, with a workspace per thread so that the lists of states are
+     * reused from one instance to the next.
+     */
+    std::function<Output(const Instance&, const Parameters&)> algorithm = nullptr;
+
+    /**
+     * Callback function called each time an instance has been solved.
+     *
+     * It is called from the thread which solved the instance.
+     */
+    std::function<void(const BatchEntry&, const Output&)> new_output_callback = nullptr;
+
+    /**
+     * Callback function called each time an instance can't be read or solved.
+     *
+     * If it is set, the other instances are still solved; otherwise, all the
+     * threads stop and the exception is rethrown. It may be called
+     * concurrently from several threads.
+     */
+    std::function<void(const BatchEntry&, const std::exception&)> error_callback = nullptr;
+
+    /**
+     * Maximum number of instances read from the manifest but not yet solved
+     * by 'solve_batch_manifest'.
+     *
+     * If 0, four times the number of threads.
+     */
+    std::size_t look_ahead = 0;
+};
+
+struct BatchOutput
+{
+    /**
+     * Output of each instance.
+     *
+     * It is empty for 'solve_batch_manifest', which doesn't keep the
+     * instances once they are solved.
+     */
+    std::vector<Output> outputs;
+
+    /** Number of instances, including the ones which failed. */
+    Counter number_of_instances = 0;
+
+    /** Number of instances which couldn't be read or solved. */
+    Counter number_of_errors = 0;
+
+    /** Elapsed time. */
+    double time = 0.0;
+
+    /** Number of instances solved per second. */
+    double throughput = 0.0;
+
+
+    nlohmann::json to_json() const
+    {
+        std::vector<Profit> values;
+        std::vector<Profit> bounds;
+        for (const Output& output: outputs) {
+            values.push_back(output.value);
+            bounds.push_back(output.bound);
+        }
+        return nlohmann::json {
+            {"NumberOfInstances", number_of_instances},
+            {"NumberOfErrors", number_of_errors},
+            {"Values", values},
+            {"Bounds", bounds},
+            {"Time", time},
+            {"Throughput", throughput}};
+    }
+
+    void format(std::ostream& os) const
+    {
+        os
+            << "Number of instances:  " << number_of_instances << std::endl
+            << "Number of errors:     " << number_of_errors << std::endl
+            << "Time (s):             " << time << std::endl
+            << "Throughput (inst/s):  " << throughput << std::endl
+            ;
+    }
+};
+
+/**
+ * Read the instances of a batch manifest.
+ *
+ * Each non-empty line of the manifest is either the path of an instance file
+ * in format 'format', or an inline instance given as a JSON object with the
+ * keys "Capacity", "Profits" and "Weights", and optionally "Name".
+ *
+ * For each instance, its path, its name or "line <line number>" is added to
+ * 'names'.
+ */
+std::vector<Instance> read_batch_manifest(
+        std::istream& manifest,
+        const std::string& format,
+        std::vector<std::string>& names);
+
+/**
+ * Read an instance from a line of a batch manifest.
+ *
+ * 'name' is set to the path of the instance file, its name or
+ * "line <line number>". Throw 'std::invalid_argument' if the line is not a
+ * valid inline instance.
+ */
+Instance read_batch_manifest_line(
+        const std::string& line,
+        Counter line_number,
+        const std::string& format,
+        std::string& name);
+
+/**
+ * Solve a batch of instances with a pool of threads.
+ *
+ * Each thread takes the next instance not yet solved, so that long instances
+ * don't delay the others.
+ */
+BatchOutput solve_batch(
+        const std::vector<Instance>& instances,
+        const BatchParameters& parameters = {});
+
+/**
+ * Solve the instances of a batch manifest while reading it.
+ *
+ * The calling thread reads the manifest line by line and hands the instances
+ * to a pool of threads, keeping at most 'parameters.look_ahead' instances
+ * read but not yet solved, so that the memory used doesn't grow with the
+ * number of instances. Each instance is released as soon as it is solved, so
+ * the results are only available through 'parameters.new_output_callback'.
+ *
+ * The format of the manifest is described in 'read_batch_manifest'.
+ */
+BatchOutput solve_batch_manifest(
+        std::istream& manifest,
+        const std::string& format,
+        const BatchParameters& parameters = {});
+
+}
@@ -0,0 +1,124 @@
+#pragma once
+
+#include "knapsacksolver/instance.hpp"
+
+namespace knapsacksolver
+{
+
+/**
+ * Structure for an item of a bounded knapsack problem.
+ */
+struct BoundedItem
+{
+    /** Weight of the item. */
+    Weight weight = 0;
+
+    /** Profit of the item. */
+    Profit profit = 0;
+
+    /** Number of copies of the item. */
+    ItemId number_of_copies = 0;
+};
+
+/**
+ * Instance class for a bounded knapsack problem.
+ *
+ * In a bounded knapsack problem, each item has a number of copies, and
+ * several copies of the same item can be selected.
+ */
+class BoundedInstance
+{
+
+public:
+
+    /*
+     * Getters
+     */
+
+    /** Get the number of items in the instance. */
+    inline ItemId number_of_items() const { return items_.size(); }
+
+    /** Get the capacity of the instance. */
+    inline Weight capacity() const { return capacity_; }
+
+    /** Get an item. */
+    inline const BoundedItem& item(ItemId item_id) const { return items_[item_id]; }
+
+    /** Get the total number of copies. */
+    inline ItemId total_number_of_copies() const { return total_number_of_copies_; }
+
+    /*
+     * Export.
+     */
+
+    /** Print the instance into a stream. */
+    void format(
+            std::ostream& os,
+            int verbosity_level = 1) const;
+
+private:
+
+    /*
+     * Private methods.
+     */
+
+    /** Manual constructor. */
+    BoundedInstance() { }
+
+    /*
+     * Private attributes
+     */
+
+    /** Items. */
+    std::vector<BoundedItem> items_;
+
+    /** Capacity of the knapsack. */
+    Weight capacity_ = 0;
+
+    /*
+     * Commputed attributes
+     */
+
+    /** Total number of copies. */
+    ItemId total_number_of_copies_ = 0;
+
+    friend class BoundedInstanceBuilder;
+
+};
+
+class BoundedInstanceBuilder
+{
+
+public:
+
+    /** Constructor. */
+    BoundedInstanceBuilder() { }
+
+    /** Add an item to the knapsack. */
+    void add_item(
+            Profit profit,
+            Weight weight,
+            ItemId number_of_copies);
+
+    /** Set the capacity of the knapsack. */
+    void set_capacity(Weight capacity) { instance_.capacity_ = capacity; }
+
+    /*
+     * Build
+     */
+
+    /** Build. */
+    BoundedInstance build();
+
+private:
+
+    /*
+     * Private attributes
+     */
+
+    /** Instance. */
+    BoundedInstance instance_;
+
+};
+
+}
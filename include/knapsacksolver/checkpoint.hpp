@@ -0,0 +1,156 @@
+#pragma once
+
+#include "knapsacksolver/solution.hpp"
+
+#include <fstream>
+#include <type_traits>
+
+namespace knapsacksolver
+{
+
+/** Magic number of the checkpoint files, "KSCHECKP". */
+constexpr char checkpoint_magic[8] = {'K', 'S', 'C', 'H', 'E', 'C', 'K', 'P'};
+
+/** Current version of the checkpoint format. */
+constexpr uint32_t checkpoint_version = 2;
+
+/**
+ * Writer of a checkpoint file.
+ *
+ * A checkpoint file starts with a header identifying the algorithm and the
+ * instance, followed by the state of the algorithm. Values are stored with
+ * their native byte order and layout, so that a checkpoint can only be read
+ * back by the same build.
+ *
+ * The state is written to a temporary file which replaces the checkpoint file
+ * on 'commit', so that an interruption while writing never corrupts the
+ * previous checkpoint.
+ */
+class CheckpointWriter
+{
+
+public:
+
+    /** Constructor. */
+    CheckpointWriter(
+            const std::string& checkpoint_path,
+            const std::string& algorithm,
+            const Instance& instance);
+
+    /** Write a value. */
+    template <typename T>
+    void write(const T& value)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "");
+        file_.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    /** Write a vector. */
+    template <typename T>
+    void write(const std::vector<T>& values)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "");
+        write((int64_t)values.size());
+        file_.write(
+                reinterpret_cast<const char*>(values.data()),
+                values.size() * sizeof(T));
+    }
+
+    /** Write the items of a solution. */
+    void write(const Solution& solution);
+
+    /** Replace the checkpoint file by the written state. */
+    void commit();
+
+private:
+
+    /** Path of the checkpoint file. */
+    std::string checkpoint_path_;
+
+    /** Path of the temporary file. */
+    std::string temporary_path_;
+
+    /** Temporary file. */
+    std::ofstream file_;
+
+};
+
+/**
+ * Reader of a checkpoint file.
+ *
+ * Throw a 'std::invalid_argument' if the checkpoint has been written by
+ * another algorithm or for another instance, identified by its size, its
+ * capacity and a hash of its items, or if it is truncated or corrupted.
+ */
+class CheckpointReader
+{
+
+public:
+
+    /** Constructor. */
+    CheckpointReader(
+            const std::string& checkpoint_path,
+            const std::string& algorithm,
+            const Instance& instance);
+
+    /** Read a value. */
+    template <typename T>
+    void read(T& value)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "");
+        file_.read(reinterpret_cast<char*>(&value), sizeof(T));
+        check();
+    }
+
+    /**
+     * Read a vector.
+     *
+     * Throw a 'std::invalid_argument' if its size is larger than
+     * 'maximum_size', when it is non-negative, or than what remains in the
+     * file, so that a corrupted size never leads to a huge allocation.
+     */
+    template <typename T>
+    void read(
+            std::vector<T>& values,
+            int64_t maximum_size = -1)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "");
+        int64_t size = 0;
+        read(size);
+        int64_t remaining_size = file_size_ - (int64_t)file_.tellg();
+        if (size < 0
+                || (maximum_size >= 0 && size > maximum_size)
+                || size > remaining_size / (int64_t)sizeof(T)) {
+            throw std::invalid_argument(
+                    "The checkpoint \"" + checkpoint_path_ + "\" is corrupted.");
+        }
+        values.resize(size);
+        file_.read(
+                reinterpret_cast<char*>(values.data()),
+                size * sizeof(T));
+        check();
+    }
+
+    /** Read the items of a solution into an empty solution. */
+    void read(Solution& solution);
+
+private:
+
+    /** Throw if the last read failed. */
+    void check();
+
+    /** Path of the checkpoint file. */
+    std::string checkpoint_path_;
+
+    /** Checkpoint file. */
+    std::ifstream file_;
+
+    /** Size of the checkpoint file, in bytes. */
+    int64_t file_size_ = 0;
+
+};
+
+/** Return 'true' iff a checkpoint file exists. */
+bool checkpoint_exists(const std::string& checkpoint_path);
+
+}
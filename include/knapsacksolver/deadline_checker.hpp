@@ -0,0 +1,130 @@
+#pragma once
+
+#include "knapsacksolver/algorithm_formatter.hpp"
+
+#include <chrono>
+
+namespace knapsacksolver
+{
+
+/**
+ * Class to check cheaply, from the inner loops of the algorithms, whether the
+ * time limit is reached or the stop flag is set.
+ *
+ * Reading the clock at each iteration of a loop whose iterations only take a
+ * few nanoseconds dominates its running time. Therefore, the clock and the
+ * stop flag are only read once every 'K' work units. 'K' is adapted from the
+ * observed cost of a work unit so that they are read approximately every
+ * 'check_interval' seconds.
+ *
+ * If an algorithm formatter is given, the value of its output is also raised
+ * to the shared lower bound at each check.
+ *
+ * Once the end has been detected, all further calls return 'true'.
+ *
+ * A checker must not be shared between threads.
+ */
+class DeadlineChecker
+{
+
+public:
+
+    /** Constructor. */
+    DeadlineChecker(
+            const Parameters& parameters,
+            AlgorithmFormatter* algorithm_formatter = nullptr,
+            double check_interval = 1e-3):
+        parameters_(parameters),
+        algorithm_formatter_(algorithm_formatter),
+        check_interval_(check_interval),
+        last_check_time_(std::chrono::steady_clock::now()) { }
+
+    /**
+     * Return 'true' iff the algorithm must end.
+     *
+     * 'number_of_units' is the amount of work done since the previous call.
+     */
+    inline bool needs_to_end(Counter number_of_units = 1)
+    {
+        countdown_ -= number_of_units;
+        if (countdown_ > 0)
+            return ended_;
+        return check();
+    }
+
+    /** Read the clock and the stop flag now. */
+    bool check()
+    {
+        if (ended_)
+            return true;
+        if (parameters_.timer.needs_to_end()
+                || (parameters_.stop != nullptr
+                    && parameters_.stop->load(std::memory_order_relaxed))) {
+            ended_ = true;
+            return true;
+        }
+        number_of_checks_++;
+        if (algorithm_formatter_ != nullptr)
+            algorithm_formatter_->update_shared_lower_bound();
+
+        // Adapt the number of work units between two checks.
+        auto time = std::chrono::steady_clock::now();
+        double elapsed = std::chrono::duration<double>(time - last_check_time_).count();
+        last_check_time_ = time;
+        double units_per_check = (double)units_per_check_ - countdown_;
+        if (elapsed * 2 < check_interval_) {
+            units_per_check_ *= 2;
+        } else if (elapsed > check_interval_ * 2) {
+            units_per_check_ = (Counter)(units_per_check * check_interval_ / elapsed);
+        }
+        if (units_per_check_ < 1)
+            units_per_check_ = 1;
+        if (units_per_check_ > maximum_units_per_check_)
+            units_per_check_ = maximum_units_per_check_;
+        countdown_ = units_per_check_;
+        return false;
+    }
+
+    /** Return 'true' iff the end has already been detected. */
+    bool ended() const { return ended_; }
+
+    /**
+     * Get the number of times the clock has been read.
+     *
+     * Other periodic tasks, such as writing checkpoints, can compare it to
+     * its previous value to only read the clock when the checker does.
+     */
+    Counter number_of_checks() const { return number_of_checks_; }
+
+private:
+
+    /** Maximum number of work units between two checks. */
+    static constexpr Counter maximum_units_per_check_ = (Counter)1 << 24;
+
+    /** Parameters. */
+    const Parameters& parameters_;
+
+    /** Algorithm formatter. */
+    AlgorithmFormatter* algorithm_formatter_;
+
+    /** Target time between two checks, in seconds. */
+    double check_interval_;
+
+    /** Number of work units between two checks. */
+    Counter units_per_check_ = 1;
+
+    /** Number of work units before the next check. */
+    Counter countdown_ = 1;
+
+    /** Time of the last check. */
+    std::chrono::steady_clock::time_point last_check_time_;
+
+    /** Number of times the clock has been read. */
+    Counter number_of_checks_ = 0;
+
+    /** 'true' iff the end has been detected. */
+    bool ended_ = false;
+
+};
+
+}
@@ -0,0 +1,125 @@
+#pragma once
+
+#include "knapsacksolver/instance.hpp"
+
+#include "nlohmann/json.hpp"
+
+#include <string>
+
+namespace knapsacksolver
+{
+
+/**
+ * Features of an instance, used to select an algorithm.
+ */
+struct InstanceFeatures
+{
+    /** Number of items. */
+    ItemId number_of_items = 0;
+
+    /** Capacity. */
+    Weight capacity = 0;
+
+    /** Ratio between the capacity and the total weight of the items. */
+    double capacity_ratio = 0.0;
+
+    /** Smallest weight. */
+    Weight minimum_weight = 0;
+
+    /** Largest weight. */
+    Weight maximum_weight = 0;
+
+    /** Smallest profit. */
+    Profit minimum_profit = 0;
+
+    /** Largest profit. */
+    Profit maximum_profit = 0;
+
+    /** Pearson correlation coefficient between the weights and the profits. */
+    double weight_profit_correlation = 0.0;
+
+    /** 'true' iff the profit of each item is equal to its weight. */
+    bool subset_sum = false;
+
+    /** Greatest common divisor of the weights and of the capacity. */
+    Weight weight_gcd = 0;
+
+    /**
+     * Estimated size of the core.
+     *
+     * It is the number of items whose efficiency differs by less than 1% from
+     * the efficiency of the break item. It is 0 if all the items fit, and -1
+     * if the break item hasn't been computed because the coefficients are too
+     * large.
+     */
+    ItemId estimated_core_size = 0;
+
+
+    /** Export the features to a JSON structure. */
+    nlohmann::json to_json() const;
+
+    /** Write a formatted output of the features to a stream. */
+    void format(std::ostream& os) const;
+};
+
+/**
+ * Compute the features of an instance.
+ *
+ * The complexity is linear in the number of items.
+ */
+InstanceFeatures compute_features(const Instance& instance);
+
+/**
+ * Algorithm selected for an instance.
+ */
+struct AlgorithmSelection
+{
+    /** Name of the algorithm, as in the main executable. */
+    std::string algorithm;
+
+    /** Use pairing in the primal-dual dynamic programming algorithm. */
+    bool pairing = false;
+
+    /** Reason of the choice. */
+    std::string reason;
+
+    /** Features from which the algorithm has been selected. */
+    InstanceFeatures features;
+
+
+    /** Export the selection and the features to a JSON structure. */
+    nlohmann::json to_json() const;
+
+    /** Write a formatted output of the features and of the selection. */
+    void format(std::ostream& os) const;
+};
+
+/**
+ * Select an algorithm from the features of an instance.
+ *
+ * The rules have been calibrated on generated instances of the classes of
+ * Pisinger and on their spanner variants, with 30 to 20000 items,
+ * coefficients up to 100000 and capacity ratios from 0.1 to 0.9:
+ * - If all the items fit, the greedy algorithm returns the optimal solution
+ *   in linear time.
+ * - If the core contains at least half of the items, the bounds of the
+ *   primal-dual algorithm can't fix many items. If moreover the Bellman
+ *   array has at most a million cells, the recursive Bellman array
+ *   algorithm is selected, since its running time doesn't depend on the
+ *   bounds. It is only selected if the GCD of the weights is 1, since the
+ *   states of the primal-dual algorithm only have weights multiple of it,
+ *   while the Bellman array contains all the capacities. On larger instances,
+ *   the primal-dual algorithm has always been faster, often by several
+ *   orders of magnitude.
+ * - Otherwise, the primal-dual algorithm is selected. Pairing is enabled on
+ *   subset sum instances and on instances with a large core whose
+ *   coefficients are large compared to the number of items, where it is
+ *   often an order of magnitude faster. It is slower on strongly correlated
+ *   instances, whose core is smaller.
+ *
+ * The Bellman list algorithm is never selected since it only computes the
+ * optimal value.
+ */
+AlgorithmSelection select_algorithm(const InstanceFeatures& features);
+
+}
@@ -3,10 +3,18 @@
 #include "knapsacksolver/instance.hpp"
 
 #include <random>
+#include <string>
 
 namespace knapsacksolver
 {
 
+/**
+ * Generate an uncorrelated instance.
+ *
+ * Weights and profits are drawn uniformly in [1, maximum_weight] and
+ * [1, maximum_profit]. The capacity is 'capacity_ratio' times the total
+ * weight of the items, and at least the weight of the heaviest item.
+ */
 Instance generate_u(
         ItemPos number_of_items,
         Weight maximum_weight,
@@ -14,4 +22,154 @@ Instance generate_u(
         double capacity_ratio,
         std::mt19937_64& generator);
 
+/**
+ * Generate a weakly correlated instance.
+ *
+ * Weights are drawn uniformly in [1, maximum_weight] and the profit of an
+ * item of weight w is drawn uniformly in
+ * [w - maximum_weight / 10, w + maximum_weight / 10], and is at least 1.
+ */
+Instance generate_wc(
+        ItemPos number_of_items,
+        Weight maximum_weight,
+        double capacity_ratio,
+        std::mt19937_64& generator);
+
+/**
+ * Generate a strongly correlated instance.
+ *
+ * Weights are drawn uniformly in [1, maximum_weight] and the profit of an
+ * item of weight w is w + maximum_weight / 10.
+ */
+Instance generate_sc(
+        ItemPos number_of_items,
+        Weight maximum_weight,
+        double capacity_ratio,
+        std::mt19937_64& generator);
+
+/**
+ * Generate a subset sum instance.
+ *
+ * Weights are drawn uniformly in [1, maximum_weight] and the profit of each
+ * item is equal to its weight.
+ */
+Instance generate_ss(
+        ItemPos number_of_items,
+        Weight maximum_weight,
+        double capacity_ratio,
+        std::mt19937_64& generator);
+
+/**
+ * Generator for the instance classes from "Where are the hard knapsack
+ * problems?" (Pisinger, 2005).
+ *
+ * The weights are drawn uniformly in [1, r], or from a normal distribution if
+ * 'normal' is set, and the profits are computed from the weights according to
+ * the type of the instance:
+ * - 'u': uncorrelated, p in [1, r]
+ * - 'wc': weakly correlated, p in [w - r / 10, w + r / 10]
+ * - 'sc': strongly correlated, p = w + r / 10
+ * - 'isc': inverse strongly correlated, p in [1, r] and w = p + r / 10
+ * - 'asc': almost strongly correlated, p in [w + r / 10 - r / 500, w + r / 10 + r / 500]
+ * - 'ss': subset sum, p = w
+ * - 'sw': uncorrelated with similar weights, w in [100000, 100100] and
+ *   p in [1, 1000]
+ * - 'mstr': multiple strongly correlated, p = w + k1 if w is a multiple of d,
+ *   p = w + k2 otherwise
+ * - 'pceil': profit ceiling, p = d * ceil(w / d)
+ * - 'circle': p = d * sqrt(4 r^2 - (w - 2 r)^2)
+ *
+ * The capacity of instance 'h' of a series of 'hmax' instances is
+ * h / (hmax + 1) times the total weight of the items.
+ */
+struct Generator
+{
+    /** Type of the instance. */
+    std::string t = "u";
+
+    /** Number of items. */
+    ItemPos n = 100;
+
+    /** Range of the coefficients. */
+    Profit r = 1000;
+
+    /** Profit offset of the items whose weight is a multiple of 'd' ('mstr'). */
+    Profit k1 = -1;
+
+    /** Profit offset of the other items ('mstr'). */
+    Profit k2 = -1;
+
+    /**
+     * Parameter 'd' of the 'mstr' (default 6), 'pceil' (default 3) and
+     * 'circle' (default 2/3) instances.
+     */
+    double d = -1;
+
+    /** Number of the instance in its series. */
+    int h = 1;
+
+    /** Number of instances of the series. */
+    int hmax = 100;
+
+    /**
+     * Ratio between the capacity and the total weight of the items.
+     *
+     * If it is set, it is used instead of 'h' and 'hmax'.
+     */
+    double x = -1;
+
+    /** Seed. */
+    Seed s = 0;
+
+    /**
+     * Generate spanner instances.
+     *
+     * 'v' spanner items are drawn according to the type of the instance and
+     * their profits and weights are divided by 'm' / 2. Each item is then a
+     * random spanner item multiplied by a random integer in [1, m].
+     */
+    bool spanner = false;
+
+    /** Number of spanner items. */
+    Profit v = 2;
+
+    /** Maximum multiplier of the spanner items. */
+    Profit m = 10;
+
+    /** Draw the weights from a normal distribution. */
+    bool normal = false;
+
+    /**
+     * Ratio between 'r' and the standard deviation of the weights when they
+     * are drawn from a normal distribution.
+     */
+    double dw = 10;
+
+
+    /**
+     * Generate an instance.
+     *
+     * The instance only depends on the attributes of the generator.
+     */
+    Instance generate() const;
+};
+
+std::ostream& operator<<(
+        std::ostream& os,
+        const Generator& generator);
+
+/**
+ * Generate instances and write them into an existing directory.
+ *
+ * Instance 'i' is generated with seed 'generator.s + i', therefore the
+ * instances don't depend on the number of threads. It is written to
+ * '<output_directory>/<t>_<n>_<r>_<seed>.txt', or '.bin' in binary format.
+ */
+void generate_instances(
+        const Generator& generator,
+        Counter number_of_instances,
+        const std::string& output_directory,
+        const std::string& format = "standard",
+        int number_of_threads = 1);
+
 }
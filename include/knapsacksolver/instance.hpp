@@ -34,6 +34,43 @@ struct Item
     double efficiency = 0.0;
 };
 
+/**
+ * Header of the binary instance format.
+ *
+ * A file in binary format contains this header followed by the profits of
+ * the items and then by the weights of the items, each stored as a 64-bit
+ * integer. Integers are stored in the native byte order.
+ */
+struct InstanceBinaryHeader
+{
+    /** Magic number, "KNAPSACK". */
+    char magic[8];
+
+    /** Version of the format. */
+    uint32_t version;
+
+    /** Padding. */
+    uint32_t padding;
+
+    /** Number of items. */
+    int64_t number_of_items;
+
+    /** Capacity of the knapsack. */
+    int64_t capacity;
+
+    /** Total item profit. */
+    int64_t total_item_profit;
+
+    /** Total item weight. */
+    int64_t total_item_weight;
+};
+
+/** Magic number of the binary instance format. */
+constexpr char instance_binary_magic[8] = {'K', 'N', 'A', 'P', 'S', 'A', 'C', 'K'};
+
+/** Current version of the binary instance format. */
+constexpr uint32_t instance_binary_version = 1;
+
 /**
  * Instance class for a knapsack problem.
  */
@@ -85,6 +122,9 @@ public:
     /** Write the instance to a file. */
     void write(std::string instance_path) const;
 
+    /** Write the instance to a file in binary format. */
+    void write_binary(std::string instance_path) const;
+
 private:
 
     /*
@@ -13,11 +13,24 @@ public:
     /** Constructor. */
     InstanceBuilder() { }
 
+    /** Reserve memory for 'number_of_items' items. */
+    void reserve(ItemId number_of_items) { instance_.items_.reserve(number_of_items); }
+
     /** Add an item to the knapsack. */
     void add_item(
             Profit profit,
             Weight weight);
 
+    /**
+     * Add items to the knapsack.
+     *
+     * 'profits' and 'weights' must contain 'number_of_items' elements.
+     */
+    void add_items(
+            const Profit* profits,
+            const Weight* weights,
+            ItemId number_of_items);
+
     /** Set the capacity of the knapsack. */
     void set_capacity(Weight capacity) { instance_.capacity_ = capacity; }
 
@@ -44,16 +57,24 @@ private:
      */
 
     /** Read an instance file in 'standard' format. */
-    void read_standard(std::ifstream& file);
+    void read_standard(const std::string& data);
 
     /** Read an instance file in 'pisinger' format. */
-    void read_pisinger(std::ifstream& file);
+    void read_pisinger(const std::string& data);
 
     /** Read an instance file in 'jooken' format. */
-    void read_jooken(std::ifstream& file);
+    void read_jooken(const std::string& data);
 
     /** Read an subset_sum instance file in 'standard' format. */
-    void read_subset_sum_standard(std::ifstream& file);
+    void read_subset_sum_standard(const std::string& data);
+
+    /** Read an instance file in 'binary' format. */
+    void read_binary(const std::string& instance_path);
+
+    /** Read an instance in 'binary' format from a buffer. */
+    void read_binary(
+            const char* data,
+            std::size_t size);
 
     /*
      * Private attributes
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "knapsacksolver/instance.hpp"
+
+#include "optimizationtools/utils/output.hpp"
+
+#include <array>
+
+namespace knapsacksolver
+{
+
+/**
+ * Values of the hardware performance counters.
+ *
+ * A counter which is not available is set to '-1'.
+ */
+struct PerformanceCounterValues
+{
+    /** Number of CPU cycles. */
+    Counter cycles = -1;
+
+    /** Number of instructions retired. */
+    Counter instructions = -1;
+
+    /** Number of last level cache misses. */
+    Counter cache_misses = -1;
+
+    /** Number of branch mispredictions. */
+    Counter branch_misses = -1;
+
+
+    /** Get the number of instructions per cycle. */
+    double instructions_per_cycle() const
+    {
+        if (cycles <= 0 || instructions < 0)
+            return -1;
+        return (double)instructions / cycles;
+    }
+
+    /** Get the difference of the counters available in both values. */
+    PerformanceCounterValues operator-(
+            const PerformanceCounterValues& values) const;
+
+    /** Add the counters available in both values. */
+    PerformanceCounterValues& operator+=(
+            const PerformanceCounterValues& values);
+
+    /**
+     * Export the counters in JSON.
+     *
+     * If 'number_of_states' is positive, the counters per state are exported
+     * as well.
+     */
+    nlohmann::json to_json(
+            Counter number_of_states = 0) const;
+
+    /** Write the counters to a stream. */
+    void format(
+            std::ostream& os,
+            int width,
+            const std::string& prefix = "",
+            Counter number_of_states = 0) const;
+};
+
+/**
+ * Class to read the hardware performance counters of the calling thread and
+ * of the threads it creates afterwards.
+ *
+ * It relies on 'perf_event_open' and is only available on Linux. The counters
+ * start when the object is constructed and only count user space events, so
+ * that they are available with the default 'perf_event_paranoid' setting.
+ * Counters which can't be opened, for example in virtual machines which don't
+ * expose them, stay unavailable.
+ *
+ * Usage:
+ *     PerformanceCounters performance_counters;
+ *     PerformanceCounterValues start = performance_counters.read();
+ *     ...
+ *     PerformanceCounterValues values = performance_counters.read() - start;
+ */
+class PerformanceCounters
+{
+
+public:
+
+    /** Constructor. */
+    PerformanceCounters();
+
+    /** Destructor. */
+    ~PerformanceCounters();
+
+    PerformanceCounters(const PerformanceCounters&) = delete;
+    PerformanceCounters& operator=(const PerformanceCounters&) = delete;
+
+    /** Return 'true' iff at least one counter is available. */
+    bool available() const;
+
+    /** Read the current values of the counters. */
+    PerformanceCounterValues read() const;
+
+private:
+
+    /**
+     * File descriptors of the cycles, instructions, cache misses and branch
+     * misses counters; '-1' if the counter is not available.
+     */
+    std::array<int, 4> file_descriptors_ = {-1, -1, -1, -1};
+
+};
+
+}
@@ -0,0 +1,167 @@
+#pragma once
+
+#include "knapsacksolver/solution.hpp"
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace knapsacksolver
+{
+
+/**
+ * Snapshot of the progress of an algorithm.
+ */
+struct ProgressSnapshot
+{
+    /** Time at which the snapshot has been taken. */
+    double time = 0.0;
+
+    /** Value. */
+    Profit value = 0;
+
+    /** Bound. */
+    Profit bound = -1;
+
+    /** 'true' iff the output contains a solution of value 'value'. */
+    bool has_solution = false;
+};
+
+using ProgressCallback = std::function<void(const ProgressSnapshot&)>;
+
+/**
+ * Class to report the progress of an algorithm from a separate thread.
+ *
+ * The algorithm publishes snapshots of its output into a lock-free single
+ * producer single consumer triple buffer; publishing never blocks and never
+ * calls user code. A reporting thread calls the user callback with the most
+ * recent snapshot, at most once every 'minimum_interval' seconds. A snapshot
+ * is only replaced by a more recent one, so that the last snapshot published
+ * is always reported; the replaced snapshots are counted.
+ *
+ * Snapshots don't contain the solution: once the algorithm has ended, it is
+ * available in its output.
+ *
+ * Usage:
+ *     ProgressReporter progress_reporter(callback, 0.1);
+ *     parameters.new_solution_callback = progress_reporter.new_solution_callback();
+ *     auto output = dynamic_programming_primal_dual(instance, parameters);
+ *     progress_reporter.stop();
+ */
+class ProgressReporter
+{
+
+public:
+
+    /** Constructor. */
+    ProgressReporter(
+            const ProgressCallback& callback,
+            double minimum_interval = 0.0);
+
+    /** Destructor. */
+    ~ProgressReporter() { stop(); }
+
+    ProgressReporter(const ProgressReporter&) = delete;
+    ProgressReporter& operator=(const ProgressReporter&) = delete;
+
+    /**
+     * Publish a snapshot of an output.
+     *
+     * It must always be called from the same thread.
+     */
+    void publish(const Output& output);
+
+    /** Get a callback publishing the outputs it receives. */
+    NewSolutionCallback new_solution_callback()
+    {
+        return [this](const Output& output) { publish(output); };
+    }
+
+    /**
+     * Stop the reporting thread.
+     *
+     * The most recent snapshot not reported yet is reported before the thread
+     * stops.
+     */
+    void stop();
+
+    /**
+     * Get the number of snapshots replaced by a more recent one before being
+     * reported.
+     */
+    Counter number_of_overwritten_snapshots() const { return number_of_overwritten_snapshots_; }
+
+    /** Get the number of times the callback has been called. */
+    Counter number_of_reports() const { return number_of_reports_; }
+
+private:
+
+    /*
+     * Private methods
+     */
+
+    /** Function run by the reporting thread. */
+    void run();
+
+    /**
+     * Pop the most recent snapshot.
+     *
+     * Return 'true' iff a snapshot has been published since the last call;
+     * 'snapshot' is then set to the most recent one.
+     */
+    bool pop(ProgressSnapshot& snapshot);
+
+    /*
+     * Private attributes
+     */
+
+    /** Callback. */
+    ProgressCallback callback_;
+
+    /** Minimum interval between two calls of the callback. */
+    double minimum_interval_;
+
+    /** Bit of 'middle_' set iff its buffer hasn't been consumed yet. */
+    static constexpr unsigned new_snapshot_bit = 4;
+
+    /**
+     * Triple buffer.
+     *
+     * The producer writes in its back buffer and exchanges it with the middle
+     * buffer; the consumer exchanges its front buffer with the middle buffer
+     * when it contains a new snapshot.
+     */
+    std::array<ProgressSnapshot, 3> buffers_;
+
+    /** Index of the back buffer; used by the producer only. */
+    unsigned back_ = 0;
+
+    /** Index of the middle buffer and 'new_snapshot_bit'. */
+    std::atomic<unsigned> middle_;
+
+    /** Index of the front buffer; used by the consumer only. */
+    unsigned front_ = 2;
+
+    /** Number of overwritten snapshots. */
+    std::atomic<Counter> number_of_overwritten_snapshots_;
+
+    /** Number of reports. */
+    std::atomic<Counter> number_of_reports_;
+
+    /** Mutex used to wait in the reporting thread. */
+    std::mutex mutex_;
+
+    /** Condition variable used to wake up the reporting thread when stopping. */
+    std::condition_variable condition_variable_;
+
+    /** 'true' iff the reporting thread must stop. */
+    bool stop_ = false;
+
+    /** Reporting thread. */
+    std::thread thread_;
+
+};
+
+}
@@ -0,0 +1,248 @@
+#pragma once
+
+#include "knapsacksolver/solution.hpp"
+
+#include <atomic>
+#include <functional>
+
+namespace knapsacksolver
+{
+
+/*
+ * Protocol of the server.
+ *
+ * The server listens on a Unix domain socket. A client sends requests on a
+ * connection and the server answers them in order. A request is made of a
+ * 'ServerRequestHeader' followed by the profits and then by the weights of
+ * the items, each stored as a 64-bit integer, as in the binary instance
+ * format.
+ *
+ * The server answers a request with a sequence of responses, each one made of
+ * a 'ServerResponseHeader' possibly followed by a payload:
+ * - if the request asked for it, a 'solution' response each time a better
+ *   solution is found; improvements of the value or of the bound alone are
+ *   not sent
+ * - then a single 'final' response, or an 'error' response
+ * The payload of a 'solution' or 'final' response is the solution, stored as
+ * a bitset of 'ceil(length / 8)' bytes; item 'i' is in the solution iff bit
+ * 'i % 8' of byte 'i / 8' is set. The payload of an 'error' response is the
+ * error message, of 'length' bytes.
+ *
+ * Integers are stored in the native byte order.
+ */
+
+/** Magic number of the requests, "KSREQUES". */
+constexpr char server_request_magic[8] = {'K', 'S', 'R', 'E', 'Q', 'U', 'E', 'S'};
+
+/** Magic number of the responses, "KSRESPON". */
+constexpr char server_response_magic[8] = {'K', 'S', 'R', 'E', 'S', 'P', 'O', 'N'};
+
+/** Current version of the protocol. */
+constexpr uint32_t server_protocol_version = 1;
+
+/** Flag of a request to receive a response for each new solution found. */
+constexpr uint32_t server_request_flag_new_solutions = 1;
+
+struct ServerRequestHeader
+{
+    /** Magic number, "KSREQUES". */
+    char magic[8];
+
+    /** Version of the protocol. */
+    uint32_t version;
+
+    /** Flags. */
+    uint32_t flags;
+
+    /** Number of items. */
+    int64_t number_of_items;
+
+    /** Capacity of the knapsack. */
+    int64_t capacity;
+
+    /** Time limit in seconds; no time limit if not positive. */
+    double time_limit;
+};
+
+enum class ServerResponseType: uint32_t
+{
+    Solution = 0,
+    Final = 1,
+    Error = 2,
+};
+
+struct ServerResponseHeader
+{
+    /** Magic number, "KSRESPON". */
+    char magic[8];
+
+    /** Version of the protocol. */
+    uint32_t version;
+
+    /** Type of the response. */
+    ServerResponseType type;
+
+    /** Value of the best solution found. */
+    int64_t value;
+
+    /** Bound. */
+    int64_t bound;
+
+    /** Time spent solving the instance, in seconds. */
+    double time;
+
+    /** Number of items, or length of the error message. */
+    int64_t length;
+};
+
+struct ServerParameters
+{
+    /** Path of the socket. */
+    std::string socket_path;
+
+    /**
+     * Number of threads.
+     *
+     * Each thread serves one connection at a time. If 0, the number of
+     * concurrent threads supported by the hardware is used.
+     */
+    int number_of_threads = 1;
+
+    /**
+     * Algorithm used to solve each instance.
+     *
+     * It may be called concurrently from several threads. The parameters
+     * given to the algorithm contain the timer, the stop flag and the new
+     * solution callback of the request; they can be forwarded with
+     * 'portfolio_algorithm_parameters'.
+     *
+     * If not set, 'dynamic_programming_primal_dual' is used, with a workspace
+     * per thread kept between requests.
+     */
+    std::function<Output(const Instance&, const Parameters&)> algorithm = nullptr;
+
+    /**
+     * If the default algorithm is used, select pairing from the features of
+     * each instance.
+     */
+    bool automatic_pairing = true;
+
+    /**
+     * If the default algorithm is used and 'automatic_pairing' is 'false',
+     * use pairing.
+     */
+    bool pairing = false;
+
+    /**
+     * Maximum number of items of a request.
+     *
+     * The coefficients of a request are received before the instance is
+     * built. A request with more items is answered with an error response and
+     * its connection is closed.
+     */
+    ItemId maximum_number_of_items = 10000000;
+
+    /**
+     * Memory limit of each request, in bytes; no limit if negative.
+     *
+     * It is given to the algorithm. A request whose coefficients and instance
+     * alone would exceed it is rejected as a request with too many items.
+     */
+    Counter memory_limit = -1;
+
+    /**
+     * Stop flag.
+     *
+     * When it is set, the server stops accepting connections, interrupts the
+     * running solves, answers them and returns.
+     */
+    const std::atomic<bool>* stop = nullptr;
+};
+
+struct ServerOutput
+{
+    /** Number of connections served. */
+    Counter number_of_connections = 0;
+
+    /** Number of requests answered. */
+    Counter number_of_requests = 0;
+
+
+    nlohmann::json to_json() const
+    {
+        return nlohmann::json {
+            {"NumberOfConnections", number_of_connections},
+            {"NumberOfRequests", number_of_requests}};
+    }
+
+    void format(std::ostream& os) const
+    {
+        os
+            << "Number of connections:  " << number_of_connections << std::endl
+            << "Number of requests:     " << number_of_requests << std::endl
+            ;
+    }
+};
+
+/**
+ * Serve requests on a Unix domain socket until the stop flag is set.
+ *
+ * An existing file at the path of the socket is replaced.
+ */
+ServerOutput serve(const ServerParameters& parameters);
+
+struct ServerResponse
+{
+    ServerResponse(const Instance& instance): solution(instance) { }
+
+    /** Solution. */
+    Solution solution;
+
+    /** Value of the best solution found. */
+    Profit value = 0;
+
+    /** Bound. */
+    Profit bound = 0;
+
+    /** Time spent by the server solving the instance, in seconds. */
+    double time = 0.0;
+};
+
+/**
+ * Client of the server.
+ */
+class ServerClient
+{
+
+public:
+
+    /** Connect to the server listening on a socket. */
+    ServerClient(const std::string& socket_path);
+
+    /** Destructor. */
+    ~ServerClient();
+
+    ServerClient(const ServerClient&) = delete;
+    ServerClient& operator=(const ServerClient&) = delete;
+
+    /**
+     * Solve an instance.
+     *
+     * If 'new_solution_callback' is set, it is called for each new solution
+     * found by the server.
+     *
+     * Throw a 'std::runtime_error' if the server answers with an error.
+     */
+    ServerResponse solve(
+            const Instance& instance,
+            double time_limit = -1,
+            const std::function<void(const ServerResponse&)>& new_solution_callback = nullptr);
+
+private:
+
+    /** File descriptor of the socket. */
+    int socket_fd_ = -1;
+
+};
+
+}
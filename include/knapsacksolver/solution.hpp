@@ -1,17 +1,55 @@
 #pragma once
 
 #include "knapsacksolver/instance.hpp"
+#include "knapsacksolver/performance_counters.hpp"
 
 #include "optimizationtools/utils/utils.hpp"
 #include "optimizationtools/utils/output.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <iomanip>
 
 namespace knapsacksolver
 {
 
+/**
+ * Header of the binary certificate format.
+ *
+ * A file in binary format contains this header followed by the words of the
+ * bitset of the solution, each stored as a 64-bit integer: item 'j' is in
+ * the solution iff bit 'j % 64' of word 'j / 64' is set. Integers are stored
+ * in the native byte order.
+ */
+struct SolutionBinaryHeader
+{
+    /** Magic number, "KSOLUTIO". */
+    char magic[8];
+
+    /** Version of the format. */
+    uint32_t version;
+
+    /** Padding. */
+    uint32_t padding;
+
+    /** Number of items of the instance. */
+    int64_t number_of_items;
+
+    /** Number of items in the solution. */
+    int64_t number_of_items_in_solution;
+};
+
+/** Magic number of the binary certificate format. */
+constexpr char solution_binary_magic[8] = {'K', 'S', 'O', 'L', 'U', 'T', 'I', 'O'};
+
+/** Current version of the binary certificate format. */
+constexpr uint32_t solution_binary_version = 1;
+
 /**
  * Solution class for a subset sum problem.
+ *
+ * The items of the solution are stored in a bitset, so that a solution takes
+ * one bit per item and is copied word by word.
  */
 class Solution
 {
@@ -57,7 +95,13 @@ public:
     inline Profit profit() const { return profit_; }
 
     /** Return 'true' iff the solution contains item 'j'. */
-    int8_t contains(ItemId item_id) const { return contains_[item_id]; }
+    int8_t contains(ItemId item_id) const { return (words_[item_id >> 6] >> (item_id & 63)) & 1; }
+
+    /**
+     * Get the number of items contained in exactly one of this solution and
+     * of 'solution'.
+     */
+    ItemPos distance(const Solution& solution) const;
 
     /** Return 'true' iff the solution is feasible. */
     bool feasible() const { return weight_ <= instance().capacity(); }
@@ -72,6 +116,9 @@ public:
     /** Write the solution to a file. */
     void write(std::string filepath) const;
 
+    /** Write the solution to a file in binary format. */
+    void write_binary(std::string filepath) const;
+
     /** Export solution characteristics to a JSON structure. */
     nlohmann::json to_json() const;
 
@@ -94,8 +141,8 @@ private:
     /** Profit of the solution. */
     Profit profit_ = 0;
 
-    /** 'contains_[j] == true' iff the solution contains item 'j'. */
-    std::vector<int8_t> contains_;
+    /** Bitset of the items of the solution. */
+    std::vector<uint64_t> words_;
 
 };
 
@@ -111,6 +158,169 @@ inline optimizationtools::ObjectiveDirection objective_direction()
     return optimizationtools::ObjectiveDirection::Maximize;
 }
 
+/**
+ * Instrumentation of an algorithm.
+ *
+ * It is only filled if 'Parameters::statistics' or
+ * 'Parameters::performance_counters' is set. Each algorithm fills the fields
+ * which are relevant to it.
+ */
+struct Statistics
+{
+    /** 'true' iff the statistics are collected. */
+    bool enabled = false;
+
+    /** Time spent in each phase of the algorithm, in seconds. */
+    std::vector<std::pair<std::string, double>> phase_times;
+
+    /** Size of the list of states after each iteration. */
+    std::vector<StateId> state_list_sizes;
+
+    /** Number of states pruned because their weight is too large. */
+    Counter number_of_states_pruned_by_weight = 0;
+
+    /**
+     * Number of states pruned because their bound is not greater than the
+     * value of the best solution found.
+     */
+    Counter number_of_states_pruned_by_bound = 0;
+
+    /** Number of states pruned because another state dominates them. */
+    Counter number_of_states_pruned_by_dominance = 0;
+
+    /** Estimated peak memory of the main structures, in bytes. */
+    Counter peak_memory = 0;
+
+    /**
+     * Number of states processed by the dynamic programming kernels.
+     *
+     * For the algorithms based on lists of states, it is the sum of the sizes
+     * of the lists which have been extended; for the algorithms based on
+     * arrays, it is the number of cells of the rows which have been computed.
+     */
+    Counter number_of_states_processed = 0;
+
+    /** 'true' iff the hardware performance counters are available. */
+    bool performance_counters_enabled = false;
+
+    /** Hardware performance counters of the whole algorithm. */
+    PerformanceCounterValues performance_counters;
+
+    /** Hardware performance counters of each phase of the algorithm. */
+    std::vector<PerformanceCounterValues> phase_performance_counters;
+
+    /** Name of the current phase; empty if there is none. */
+    std::string current_phase;
+
+    /** Start time of the current phase. */
+    double current_phase_start = 0.0;
+
+    /** Performance counters at the start of the current phase. */
+    PerformanceCounterValues current_phase_performance_counters_start;
+
+
+    /** End the current phase and start a new one. */
+    void start_phase(
+            const std::string& name,
+            double time,
+            const PerformanceCounterValues& performance_counters_values = PerformanceCounterValues())
+    {
+        end_phase(time, performance_counters_values);
+        current_phase = name;
+        current_phase_start = time;
+        current_phase_performance_counters_start = performance_counters_values;
+    }
+
+    /** End the current phase. */
+    void end_phase(
+            double time,
+            const PerformanceCounterValues& performance_counters_values = PerformanceCounterValues())
+    {
+        if (current_phase.empty())
+            return;
+        PerformanceCounterValues phase_values
+            = performance_counters_values - current_phase_performance_counters_start;
+        auto it = std::find_if(
+                phase_times.begin(),
+                phase_times.end(),
+                [this](const std::pair<std::string, double>& phase_time)
+                {
+                    return phase_time.first == current_phase;
+                });
+        if (it == phase_times.end()) {
+            phase_times.push_back({current_phase, time - current_phase_start});
+            phase_performance_counters.push_back(phase_values);
+        } else {
+            it->second += time - current_phase_start;
+            phase_performance_counters[it - phase_times.begin()] += phase_values;
+        }
+        current_phase.clear();
+    }
+
+    /** Update the peak memory. */
+    void update_peak_memory(Counter memory)
+    {
+        if (peak_memory < memory)
+            peak_memory = memory;
+    }
+
+    /** Get the maximum size of the list of states. */
+    StateId maximum_state_list_size() const
+    {
+        return (state_list_sizes.empty())? 0:
+            *std::max_element(state_list_sizes.begin(), state_list_sizes.end());
+    }
+
+    nlohmann::json to_json() const
+    {
+        nlohmann::json json_phase_times = nlohmann::json::object();
+        for (const auto& phase_time: phase_times)
+            json_phase_times[phase_time.first] = phase_time.second;
+        nlohmann::json json {
+            {"PhaseTimes", json_phase_times},
+            {"StateListSizes", state_list_sizes},
+            {"MaximumStateListSize", maximum_state_list_size()},
+            {"NumberOfStatesPrunedByWeight", number_of_states_pruned_by_weight},
+            {"NumberOfStatesPrunedByBound", number_of_states_pruned_by_bound},
+            {"NumberOfStatesPrunedByDominance", number_of_states_pruned_by_dominance},
+            {"PeakMemory", peak_memory},
+            {"NumberOfStatesProcessed", number_of_states_processed}};
+        if (performance_counters_enabled) {
+            json["PerformanceCounters"] = performance_counters.to_json(
+                    number_of_states_processed);
+            // The states are processed in the dynamic programming phase.
+            for (std::size_t phase_pos = 0;
+                    phase_pos < phase_times.size();
+                    ++phase_pos) {
+                const std::string& phase = phase_times[phase_pos].first;
+                json["PhasePerformanceCounters"][phase]
+                    = phase_performance_counters[phase_pos].to_json(
+                            (phase == "DynamicProgramming")? number_of_states_processed: 0);
+            }
+        }
+        return json;
+    }
+
+    void format(
+            std::ostream& os,
+            int width) const
+    {
+        for (const auto& phase_time: phase_times) {
+            os << std::setw(width) << std::left << ("Time " + phase_time.first + " (s): ") << phase_time.second << std::endl;
+        }
+        os
+            << std::setw(width) << std::left << "Maximum state list size: " << maximum_state_list_size() << std::endl
+            << std::setw(width) << std::left << "States pruned by weight: " << number_of_states_pruned_by_weight << std::endl
+            << std::setw(width) << std::left << "States pruned by bound: " << number_of_states_pruned_by_bound << std::endl
+            << std::setw(width) << std::left << "States pruned by dominance: " << number_of_states_pruned_by_dominance << std::endl
+            << std::setw(width) << std::left << "Peak memory (bytes): " << peak_memory << std::endl
+            << std::setw(width) << std::left << "States processed: " << number_of_states_processed << std::endl
+            ;
+        if (performance_counters_enabled)
+            performance_counters.format(os, width, "", number_of_states_processed);
+    }
+};
+
 /**
  * Output structure for a set covering problem.
  */
@@ -135,6 +345,9 @@ struct Output: optimizationtools::Output
     /** Elapsed time. */
     double time = 0.0;
 
+    /** Statistics. */
+    Statistics statistics;
+
 
     std::string solution_value() const
     {
@@ -166,7 +379,7 @@ struct Output: optimizationtools::Output
 
     virtual nlohmann::json to_json() const
     {
-        return nlohmann::json {
+        nlohmann::json json {
             {"Solution", solution.to_json()},
             {"HasSolution", has_solution()},
             {"Value", value},
@@ -175,6 +388,9 @@ struct Output: optimizationtools::Output
             {"RelativeOptimalityGap", relative_optimality_gap()},
             {"Time", time}
         };
+        if (statistics.enabled)
+            json["Statistics"] = statistics.to_json();
+        return json;
     }
 
     virtual int format_width() const { return 30; }
@@ -190,11 +406,15 @@ struct Output: optimizationtools::Output
             << std::setw(width) << std::left << "Relative optimality gap (%): " << relative_optimality_gap() * 100 << std::endl
             << std::setw(width) << std::left << "Time (s): " << time << std::endl
             ;
+        if (statistics.enabled)
+            statistics.format(os, width);
     }
 };
 
 using NewSolutionCallback = std::function<void(const Output&)>;
 
+struct AlgorithmSelection;
+
 struct Parameters: optimizationtools::Parameters
 {
     /** Callback function called when a new best solution is found. */
@@ -203,25 +423,197 @@ struct Parameters: optimizationtools::Parameters
     /** Enable json output. */
     bool json_output = false;
 
+    /**
+     * Initial solution.
+     *
+     * It must be a feasible solution of the instance to solve. The output is
+     * initialized with it before the algorithm starts.
+     */
+    const Solution* initial_solution = nullptr;
+
+    /**
+     * Known lower bound, for example the value of a solution from a previous
+     * run.
+     *
+     * The value of the output is initialized with it before the algorithm
+     * starts, and the algorithms only look for solutions strictly better than
+     * it. Therefore, if it is optimal, the output might not contain a
+     * solution. It must not be greater than the optimal value.
+     */
+    Profit lower_bound = -1;
+
+    /**
+     * External stop flag.
+     *
+     * If it is set, the algorithm stops as soon as it notices that the flag
+     * has been set to 'true', as when the time limit is reached. It is read
+     * with the same frequency as the timer.
+     */
+    const std::atomic<bool>* stop = nullptr;
+
+    /**
+     * Lower bound shared between algorithms running concurrently.
+     *
+     * The algorithm raises it to the value of each new best solution it
+     * finds, and regularly raises the value of its output to it, as for
+     * 'lower_bound'. Only values of solutions are shared, so that another
+     * algorithm always holds a solution of the shared value.
+     */
+    std::atomic<Profit>* shared_lower_bound = nullptr;
+
+    /**
+     * Memory limit, in bytes; no limit if negative.
+     *
+     * The algorithms estimate the memory used by their main structures before
+     * allocating them, or while their lists of states grow. Over the limit,
+     * they fall back to a leaner variant when there is one, and throw a
+     * 'MemoryLimitExceeded' otherwise.
+     */
+    Counter memory_limit = -1;
+
+    /**
+     * Collect statistics in 'Output::statistics'.
+     *
+     * When it is not set, the algorithms only maintain counters local to
+     * their inner loops, which have no measurable cost.
+     */
+    bool statistics = false;
+
+    /**
+     * Read the hardware performance counters during the algorithm and its
+     * phases, in 'Output::statistics'.
+     *
+     * It implies collecting the statistics, which provide the number of
+     * states processed. The counters are only available on Linux, and only
+     * if the kernel and the hardware expose them.
+     */
+    bool performance_counters = false;
+
+    /**
+     * Selection of the algorithm, if it has been selected from the features
+     * of the instance.
+     *
+     * The features and the reason of the choice are then written with the
+     * instance and in the JSON output.
+     */
+    const AlgorithmSelection* algorithm_selection = nullptr;
+
 
     virtual nlohmann::json to_json() const override
     {
         nlohmann::json json = optimizationtools::Parameters::to_json();
-        json.merge_patch(
-            {});
+        json.merge_patch({
+                {"HasInitialSolution", (initial_solution != nullptr)},
+                {"LowerBound", lower_bound},
+                {"HasStop", (stop != nullptr)},
+                {"HasSharedLowerBound", (shared_lower_bound != nullptr)},
+                {"MemoryLimit", memory_limit},
+                {"Statistics", statistics},
+                {"PerformanceCounters", performance_counters}});
         return json;
     }
 
-    virtual int format_width() const override { return 23; }
+    virtual int format_width() const override { return 25; }
 
     virtual void format(std::ostream& os) const override
     {
         optimizationtools::Parameters::format(os);
-        //int width = format_width();
-        //os
-        //    << std::setw(width) << std::left << "    Enable: " << reduction_parameters.reduce << std::endl
-        //    ;
+        int width = format_width();
+        os
+            << std::setw(width) << std::left << "Has initial solution: " << (initial_solution != nullptr) << std::endl
+            << std::setw(width) << std::left << "Lower bound: " << lower_bound << std::endl
+            << std::setw(width) << std::left << "Has stop: " << (stop != nullptr) << std::endl
+            << std::setw(width) << std::left << "Has shared lower bound: " << (shared_lower_bound != nullptr) << std::endl
+            << std::setw(width) << std::left << "Memory limit: " << memory_limit << std::endl
+            << std::setw(width) << std::left << "Statistics: " << statistics << std::endl
+            << std::setw(width) << std::left << "Performance counters: " << performance_counters << std::endl
+            ;
+    }
+};
+
+/**
+ * Exception thrown by an algorithm which would use more memory than the
+ * memory limit of its parameters.
+ */
+class MemoryLimitExceeded: public std::runtime_error
+{
+
+public:
+
+    /** Constructor. */
+    MemoryLimitExceeded(
+            const std::string& algorithm,
+            double required_memory,
+            Counter memory_limit):
+        std::runtime_error(
+                "Algorithm \"" + algorithm + "\" requires about "
+                + std::to_string((Counter)required_memory)
+                + " bytes, more than the memory limit of "
+                + std::to_string(memory_limit) + " bytes."),
+        algorithm_(algorithm),
+        required_memory_(required_memory),
+        memory_limit_(memory_limit) { }
+
+    /** Get the algorithm. */
+    const std::string& algorithm() const { return algorithm_; }
+
+    /** Get the estimated memory required by the algorithm, in bytes. */
+    double required_memory() const { return required_memory_; }
+
+    /** Get the memory limit, in bytes. */
+    Counter memory_limit() const { return memory_limit_; }
+
+    nlohmann::json to_json() const
+    {
+        return nlohmann::json {
+            {"Type", "MemoryLimitExceeded"},
+            {"Message", what()},
+            {"Algorithm", algorithm_},
+            {"RequiredMemory", required_memory_},
+            {"MemoryLimit", memory_limit_}};
     }
+
+private:
+
+    /** Algorithm. */
+    std::string algorithm_;
+
+    /** Estimated memory required by the algorithm, in bytes. */
+    double required_memory_;
+
+    /** Memory limit, in bytes. */
+    Counter memory_limit_;
+
 };
 
+/**
+ * Return 'true' iff 'memory' bytes fit in the memory limit of the parameters.
+ *
+ * Memory estimates are computed with doubles so that they don't overflow.
+ */
+inline bool fits_memory_limit(
+        const Parameters& parameters,
+        double memory)
+{
+    return parameters.memory_limit < 0
+        || memory <= (double)parameters.memory_limit;
+}
+
+/**
+ * Throw a 'MemoryLimitExceeded' if 'memory' bytes don't fit in the memory
+ * limit of the parameters.
+ */
+inline void check_memory_limit(
+        const Parameters& parameters,
+        const std::string& algorithm,
+        double memory)
+{
+    if (!fits_memory_limit(parameters, memory)) {
+        throw MemoryLimitExceeded(
+                algorithm,
+                memory,
+                parameters.memory_limit);
+    }
+}
+
 }
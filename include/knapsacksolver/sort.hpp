@@ -5,6 +5,9 @@
 namespace knapsacksolver
 {
 
+class CheckpointWriter;
+class CheckpointReader;
+
 class FullSort
 {
 
@@ -110,6 +113,16 @@ public:
             ItemPos item_pos,
             ItemPos new_item_pos);
 
+    /** Write the state of the partial sort to a checkpoint. */
+    void write_checkpoint(CheckpointWriter& writer) const;
+
+    /**
+     * Restore the state of the partial sort from a checkpoint.
+     *
+     * The partial sort must have been built for the same instance.
+     */
+    void read_checkpoint(CheckpointReader& reader);
+
 private:
 
     struct Interval
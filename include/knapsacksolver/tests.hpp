@@ -42,6 +42,13 @@ const Solution get_solution(
         const Instance& instance,
         const TestInstancePath& files);
 
+/**
+ * Build an instance with 'number_of_items' items of profits 1, 2, 3, ... and
+ * of weights between 1 and 7, and a capacity of 10 per item.
+ */
+const Instance build_test_instance(
+        ItemId number_of_items);
+
 class ExactAlgorithmTest: public testing::TestWithParam<TestParams> { };
 class ExactNoSolutionAlgorithmTest: public testing::TestWithParam<TestParams> { };
 
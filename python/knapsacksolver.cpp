@@ -2,29 +2,84 @@
 #include "knapsacksolver/instance_builder.hpp"
 
 #include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
 
 namespace py = pybind11;
 
-knapsacksolver::Solution solve(
-        knapsacksolver::Instance& instance,
-        bool verbosity_level)
+using Int64Array = py::array_t<int64_t, py::array::c_style | py::array::forcecast>;
+
+void add_items(
+        knapsacksolver::InstanceBuilder& instance_builder,
+        const Int64Array& profits,
+        const Int64Array& weights)
+{
+    if (profits.ndim() != 1 || weights.ndim() != 1) {
+        throw std::invalid_argument(
+                "'profits' and 'weights' must be one-dimensional arrays.");
+    }
+    if (profits.shape(0) != weights.shape(0)) {
+        throw std::invalid_argument(
+                "'profits' and 'weights' must have the same size.");
+    }
+    // The arrays are read in place when they are C-contiguous int64 arrays.
+    instance_builder.add_items(
+            profits.data(),
+            weights.data(),
+            profits.shape(0));
+}
+
+knapsacksolver::Output solve_output(
+        const knapsacksolver::Instance& instance,
+        int verbosity_level)
 {
     knapsacksolver::DynamicProgrammingPrimalDualParameters parameters;
     parameters.verbosity_level = verbosity_level;
-    auto output = knapsacksolver::dynamic_programming_primal_dual(
+    // The instance is not accessed from Python during the resolution.
+    py::gil_scoped_release release;
+    return knapsacksolver::dynamic_programming_primal_dual(
             instance,
             parameters);
-    return output.solution;
+}
+
+knapsacksolver::Solution solve(
+        const knapsacksolver::Instance& instance,
+        int verbosity_level)
+{
+    return solve_output(instance, verbosity_level).solution;
+}
+
+py::array_t<bool> solve_mask(
+        const knapsacksolver::Instance& instance,
+        int verbosity_level)
+{
+    knapsacksolver::Output output = solve_output(instance, verbosity_level);
+    py::array_t<bool> mask(instance.number_of_items());
+    auto mask_data = mask.mutable_unchecked<1>();
+    for (knapsacksolver::ItemId item_id = 0;
+            item_id < instance.number_of_items();
+            ++item_id) {
+        mask_data(item_id) = output.solution.contains(item_id);
+    }
+    return mask;
 }
 
 PYBIND11_MODULE(knapsacksolver, m)
 {
-    py::class_<knapsacksolver::Instance>(m, "Instance");
-    py::class_<knapsacksolver::InstanceBuilder>(m, "Instance")
+    py::class_<knapsacksolver::Instance>(m, "Instance")
+        .def("number_of_items", &knapsacksolver::Instance::number_of_items)
+        .def("capacity", &knapsacksolver::Instance::capacity);
+    py::class_<knapsacksolver::InstanceBuilder>(m, "InstanceBuilder")
         .def(py::init<>())
-        .def("read", &knapsacksolver::InstanceBuilder::read)
+        .def("read", &knapsacksolver::InstanceBuilder::read,
+                py::arg("instance_path"),
+                py::arg("format") = "standard")
         .def("set_capacity", &knapsacksolver::InstanceBuilder::set_capacity)
-        .def("add_item", &knapsacksolver::InstanceBuilder::add_item);
+        .def("reserve", &knapsacksolver::InstanceBuilder::reserve)
+        .def("add_item", &knapsacksolver::InstanceBuilder::add_item)
+        .def("add_items", &add_items,
+                py::arg("profits"),
+                py::arg("weights"))
+        .def("build", &knapsacksolver::InstanceBuilder::build);
     py::class_<knapsacksolver::Solution>(m, "Solution")
         .def("contains", &knapsacksolver::Solution::contains)
         .def("number_of_items", &knapsacksolver::Solution::number_of_items)
@@ -32,5 +87,9 @@ PYBIND11_MODULE(knapsacksolver, m)
         .def("weight", &knapsacksolver::Solution::weight);
     m.def("solve", &solve,
             py::arg("instance"),
-            py::arg("verbosity_level") = 1);
+            py::arg("verbosity_level") = 1,
+            py::keep_alive<0, 1>());
+    m.def("solve_mask", &solve_mask,
+            py::arg("instance"),
+            py::arg("verbosity_level") = 0);
 }
@@ -0,0 +1,90 @@
+import argparse
+import json
+import os
+import subprocess
+import sys
+
+parser = argparse.ArgumentParser(description='')
+parser.add_argument('directory')
+parser.add_argument(
+        "-f", "--filter",
+        type=str,
+        default="",
+        help='regular expression selecting the benchmarks to run')
+parser.add_argument(
+        "-c", "--compare",
+        type=str,
+        help='JSON output of a previous run to compare with')
+parser.add_argument(
+        "-t", "--threshold",
+        type=float,
+        default=0.1,
+        help='relative slowdown reported as a regression')
+parser.add_argument(
+        "-p", "--performance-counters",
+        action='store_true',
+        help='report the hardware performance counters (Linux only)')
+
+args = parser.parse_args()
+
+
+benchmarks_main = os.path.join(
+        "build",
+        "benchmark",
+        "KnapsackSolver_benchmarks")
+
+
+# Name the output after the current commit so that runs are comparable.
+commit = subprocess.check_output(
+        ["git", "rev-parse", "--short", "HEAD"]).decode().strip()
+json_output_path = os.path.join(args.directory, commit + ".json")
+if not os.path.exists(args.directory):
+    os.makedirs(args.directory)
+
+command = (
+        benchmarks_main
+        + "  --benchmark_out=\"" + json_output_path + "\""
+        + "  --benchmark_out_format=json")
+if args.filter:
+    command += "  --benchmark_filter=\"" + args.filter + "\""
+if args.performance_counters:
+    os.environ["KNAPSACKSOLVER_PERFORMANCE_COUNTERS"] = "1"
+print(command)
+status = os.system(command)
+if status != 0:
+    sys.exit(1)
+print()
+
+
+if args.compare is not None:
+
+    def read_benchmarks(path):
+        with open(path) as f:
+            return {
+                    benchmark["name"]: benchmark
+                    for benchmark in json.load(f)["benchmarks"]}
+
+    benchmarks_old = read_benchmarks(args.compare)
+    benchmarks_new = read_benchmarks(json_output_path)
+
+    print("Comparison with " + args.compare)
+    print("-" * (16 + len(args.compare)))
+    print()
+    number_of_regressions = 0
+    for name, benchmark_new in benchmarks_new.items():
+        if name not in benchmarks_old:
+            continue
+        benchmark_old = benchmarks_old[name]
+        time_old = benchmark_old["real_time"]
+        time_new = benchmark_new["real_time"]
+        ratio = time_new / time_old if time_old > 0 else 1.0
+        status = ""
+        if ratio > 1 + args.threshold:
+            status = "  REGRESSION"
+            number_of_regressions += 1
+        if benchmark_new.get("Value") != benchmark_old.get("Value"):
+            status += "  VALUE CHANGED"
+        print("{:<72} {:>10.3f} {:>10.3f} {:>+8.1%}{}".format(
+            name, time_old, time_new, ratio - 1, status))
+    print()
+    print("Number of regressions: " + str(number_of_regressions))
@@ -1,5 +1,7 @@
 #include "knapsacksolver/algorithm_formatter.hpp"
 
+#include "knapsacksolver/features.hpp"
+
 #include "optimizationtools/utils/utils.hpp"
 
 #include <iomanip>
@@ -9,8 +11,44 @@ using namespace knapsacksolver;
 void AlgorithmFormatter::start(
         const std::string& algorithm_name)
 {
-    if (parameters_.json_output)
+    if (parameters_.json_output) {
         output_.json["Parameters"] = parameters_.to_json();
+        if (parameters_.algorithm_selection != nullptr)
+            output_.json["AlgorithmSelection"] = parameters_.algorithm_selection->to_json();
+    }
+    output_.statistics.enabled = parameters_.statistics
+        || parameters_.performance_counters;
+    if (parameters_.performance_counters) {
+        performance_counters_.reset(new PerformanceCounters());
+        if (performance_counters_->available()) {
+            output_.statistics.performance_counters_enabled = true;
+            performance_counters_start_ = performance_counters_->read();
+        } else {
+            performance_counters_.reset();
+        }
+    }
+
+    // Initialize the output with the initial solution and the lower bound.
+    if (parameters_.initial_solution != nullptr) {
+        const Solution& initial_solution = *parameters_.initial_solution;
+        if (&initial_solution.instance() != &output_.solution.instance()) {
+            throw std::invalid_argument(
+                    "The initial solution must be a solution of the instance to solve.");
+        }
+        if (!initial_solution.feasible()) {
+            throw std::invalid_argument(
+                    "The initial solution must be feasible.");
+        }
+        output_.solution = initial_solution;
+        output_.value = initial_solution.objective_value();
+    }
+    if (output_.value < parameters_.lower_bound)
+        output_.value = parameters_.lower_bound;
+    if (parameters_.shared_lower_bound != nullptr) {
+        Profit shared_lower_bound = parameters_.shared_lower_bound->load();
+        if (output_.value < shared_lower_bound)
+            output_.value = shared_lower_bound;
+    }
 
     if (parameters_.verbosity_level == 0)
         return;
@@ -22,6 +60,13 @@ void AlgorithmFormatter::start(
         << "Instance" << std::endl
         << "--------" << std::endl;
     output_.solution.instance().format(*os_, parameters_.verbosity_level);
+    if (parameters_.algorithm_selection != nullptr) {
+        *os_
+            << std::endl
+            << "Algorithm selection" << std::endl
+            << "-------------------" << std::endl;
+        parameters_.algorithm_selection->format(*os_);
+    }
     *os_
         << std::endl
         << "Algorithm" << std::endl
@@ -31,6 +76,12 @@ void AlgorithmFormatter::start(
         << "Parameters" << std::endl
         << "----------" << std::endl;
     parameters_.format(*os_);
+    if (parameters_.performance_counters
+            && !output_.statistics.performance_counters_enabled) {
+        *os_
+            << std::endl
+            << "WARNING: the hardware performance counters are not available." << std::endl;
+    }
 }
 
 void AlgorithmFormatter::print_header()
@@ -92,6 +143,13 @@ void AlgorithmFormatter::update_solution(
         output_.time = parameters_.timer.elapsed_time();
         output_.solution = solution_new;
         output_.value = output_.solution.objective_value();
+        if (parameters_.shared_lower_bound != nullptr) {
+            Profit shared_lower_bound = parameters_.shared_lower_bound->load();
+            while (shared_lower_bound < output_.value
+                    && !parameters_.shared_lower_bound->compare_exchange_weak(
+                        shared_lower_bound,
+                        output_.value)) { }
+        }
         print(s);
         if (parameters_.json_output)
             output_.json["IntermediaryOutputs"].push_back(output_.to_json());
@@ -133,9 +191,76 @@ void AlgorithmFormatter::update_bound(
     }
 }
 
+void AlgorithmFormatter::update_shared_lower_bound()
+{
+    if (parameters_.shared_lower_bound == nullptr)
+        return;
+    update_value(
+            parameters_.shared_lower_bound->load(std::memory_order_relaxed),
+            "shared lower bound");
+}
+
+std::string AlgorithmFormatter::iteration_comment(
+        Counter iteration,
+        const char* suffix) const
+{
+    if (parameters_.verbosity_level == 0)
+        return std::string();
+    return "it " + std::to_string(iteration) + suffix;
+}
+
+void AlgorithmFormatter::update_value(
+        Weight value_new,
+        Counter iteration,
+        const char* suffix)
+{
+    if (!optimizationtools::is_value_strictly_better(
+                objective_direction(),
+                output_.value,
+                value_new)) {
+        return;
+    }
+    update_value(value_new, iteration_comment(iteration, suffix));
+}
+
+void AlgorithmFormatter::update_bound(
+        Weight bound_new,
+        Counter iteration,
+        const char* suffix)
+{
+    if (!optimizationtools::is_bound_strictly_better(
+            objective_direction(),
+            output_.bound,
+            bound_new)) {
+        return;
+    }
+    update_bound(bound_new, iteration_comment(iteration, suffix));
+}
+
+void AlgorithmFormatter::start_phase(
+        const std::string& name)
+{
+    if (!output_.statistics.enabled)
+        return;
+    output_.statistics.start_phase(
+            name,
+            parameters_.timer.elapsed_time(),
+            (performance_counters_ != nullptr)?
+                performance_counters_->read():
+                PerformanceCounterValues());
+}
+
 void AlgorithmFormatter::end()
 {
     output_.time = parameters_.timer.elapsed_time();
+    if (performance_counters_ != nullptr) {
+        PerformanceCounterValues performance_counters_end = performance_counters_->read();
+        output_.statistics.end_phase(output_.time, performance_counters_end);
+        output_.statistics.performance_counters
+            = performance_counters_end - performance_counters_start_;
+    } else if (output_.statistics.enabled) {
+        output_.statistics.end_phase(output_.time);
+    }
     if (parameters_.json_output)
         output_.json["Output"] = output_.to_json();
 
@@ -0,0 +1,123 @@
+#include "knapsacksolver/algorithms/binary_splitting.hpp"
+
+#include "knapsacksolver/instance_builder.hpp"
+#include "knapsacksolver/algorithms/dynamic_programming_primal_dual.hpp"
+
+using namespace knapsacksolver;
+
+namespace
+{
+
+/**
+ * Get the number of copies of an item which fit in the knapsack; 0 if the
+ * item doesn't fit.
+ */
+ItemId binary_number_of_copies(
+        const BoundedInstance& bounded_instance,
+        ItemId item_id)
+{
+    const BoundedItem& item = bounded_instance.item(item_id);
+    if (item.weight > bounded_instance.capacity())
+        return 0;
+    if (item.weight == 0)
+        return item.number_of_copies;
+    return (std::min)(
+            item.number_of_copies,
+            bounded_instance.capacity() / item.weight);
+}
+
+}
+
+const BinarySplittingOutput knapsacksolver::binary_splitting(
+        const BoundedInstance& bounded_instance,
+        const BinarySplittingParameters& parameters)
+{
+    BinarySplittingOutput output(bounded_instance);
+
+    // Count the items of the 0-1 knapsack instance, to check its memory
+    // before building it.
+    ItemId number_of_binary_items = 0;
+    for (ItemId item_id = 0;
+            item_id < bounded_instance.number_of_items();
+            ++item_id) {
+        ItemId number_of_copies = binary_number_of_copies(
+                bounded_instance,
+                item_id);
+        for (ItemId k = 1; number_of_copies > 0; k *= 2) {
+            number_of_copies -= (std::min)(k, number_of_copies);
+            number_of_binary_items++;
+        }
+    }
+    check_memory_limit(
+            parameters,
+            "binary-splitting",
+            (double)number_of_binary_items
+            * (sizeof(Item) + sizeof(std::pair<ItemId, ItemId>)));
+
+    // Build the 0-1 knapsack instance.
+    InstanceBuilder instance_builder;
+    instance_builder.set_capacity(bounded_instance.capacity());
+    // For each item of the 0-1 knapsack instance, the corresponding item of
+    // the bounded instance and its number of copies.
+    std::vector<std::pair<ItemId, ItemId>> binary2bounded;
+    binary2bounded.reserve(number_of_binary_items);
+    for (ItemId item_id = 0;
+            item_id < bounded_instance.number_of_items();
+            ++item_id) {
+        const BoundedItem& item = bounded_instance.item(item_id);
+        ItemId number_of_copies = binary_number_of_copies(
+                bounded_instance,
+                item_id);
+
+        // Split the item.
+        for (ItemId k = 1; number_of_copies > 0; k *= 2) {
+            ItemId m = (std::min)(k, number_of_copies);
+            if (item.profit > std::numeric_limits<Profit>::max() / m) {
+                throw std::overflow_error(
+                        "Overflow: 'item.profit * number_of_copies' "
+                        "must not exceed the maximum profit value.");
+            }
+            instance_builder.add_item(m * item.profit, m * item.weight);
+            binary2bounded.push_back({item_id, m});
+            number_of_copies -= m;
+        }
+    }
+    const Instance instance = instance_builder.build();
+    output.number_of_binary_items = instance.number_of_items();
+
+    // Solve the 0-1 knapsack instance.
+    // The parameters apply to the 0-1 knapsack instance, except the ones
+    // referring to the bounded instance or to its output.
+    DynamicProgrammingPrimalDualParameters binary_parameters;
+    static_cast<Parameters&>(binary_parameters) = parameters;
+    binary_parameters.initial_solution = nullptr;
+    binary_parameters.new_solution_callback = [](const Output&) { };
+    binary_parameters.algorithm_selection = nullptr;
+    Output binary_output(instance);
+    if (parameters.algorithm) {
+        binary_output = parameters.algorithm(instance, binary_parameters);
+    } else {
+        binary_output = dynamic_programming_primal_dual(
+                instance,
+                binary_parameters);
+    }
+
+    // Retrieve the number of copies of each item.
+    for (ItemId binary_item_id = 0;
+            binary_item_id < instance.number_of_items();
+            ++binary_item_id) {
+        if (!binary_output.solution.contains(binary_item_id))
+            continue;
+        const std::pair<ItemId, ItemId>& p = binary2bounded[binary_item_id];
+        output.number_of_copies[p.first] += p.second;
+        output.weight += instance.item(binary_item_id).weight;
+    }
+    // If the lower bound is optimal, the algorithm might not return any
+    // solution: the value is the one of the copies retrieved, so that it is
+    // consistent with them, and the caller keeps its own solution.
+    output.value = binary_output.solution.profit();
+    output.bound = binary_output.bound;
+    output.statistics = binary_output.statistics;
+    output.time = parameters.timer.elapsed_time();
+    return output;
+}
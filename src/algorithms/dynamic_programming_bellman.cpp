@@ -1,17 +1,66 @@
 #include "knapsacksolver/algorithms/dynamic_programming_bellman.hpp"
 
 #include "knapsacksolver/algorithm_formatter.hpp"
+#include "knapsacksolver/deadline_checker.hpp"
 #include "knapsacksolver/sort.hpp"
+#include "knapsacksolver/checkpoint.hpp"
 #include "knapsacksolver/upper_bound.hpp"
 #include "knapsacksolver/algorithms/upper_bound_dantzig.hpp"
 #include "knapsacksolver/algorithms/greedy.hpp"
 
 #include "optimizationtools/containers/partial_set.hpp"
 
+#include <cstdio>
 #include <thread>
 
+#ifdef _WIN32
+#include <cerrno>
+#include <fcntl.h>
+#include <io.h>
+#include <random>
+#include <sys/stat.h>
+#else
+#include <stdlib.h>
+#include <unistd.h>
+#endif
+
 using namespace knapsacksolver;
 
+namespace
+{
+
+/**
+ * Get the parameters of the algorithm an algorithm falls back to from the
+ * parameters of the algorithm.
+ */
+template <typename AlgorithmParameters>
+AlgorithmParameters fallback_parameters(
+        const Parameters& parameters)
+{
+    AlgorithmParameters algorithm_parameters;
+    static_cast<Parameters&>(algorithm_parameters) = parameters;
+    return algorithm_parameters;
+}
+
+/** Estimate the memory of a row of values for capacities 0 to 'capacity'. */
+double values_memory(Weight capacity)
+{
+    return (double)(capacity + 1) * sizeof(Profit);
+}
+
+/**
+ * Get the number of cells of a row of values for capacities 0 to 'capacity'
+ * computed when adding an item.
+ */
+Counter number_of_cells(
+        Weight capacity,
+        const Item& item)
+{
+    return (item.weight <= capacity)? capacity - item.weight + 1: 0;
+}
+
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////////// dynamic_programming_bellman_array ///////////////////////
 ////////////////////////////////////////////////////////////////////////////////
@@ -24,7 +73,13 @@ Output knapsacksolver::dynamic_programming_bellman_array(
     AlgorithmFormatter algorithm_formatter(parameters, output);
     algorithm_formatter.start("Dynamic programming - Bellman - array - no solution");
     algorithm_formatter.print_header();
+    check_memory_limit(
+            parameters,
+            "dynamic-programming-bellman-array",
+            values_memory(instance.capacity()));
+    DeadlineChecker deadline_checker(parameters, &algorithm_formatter);
 
+    algorithm_formatter.start_phase("DynamicProgramming");
     std::vector<Profit> values(instance.capacity() + 1, 0);
     for (ItemId item_id = 0;
             item_id < instance.number_of_items();
@@ -32,7 +87,7 @@ Output knapsacksolver::dynamic_programming_bellman_array(
         const Item& item = instance.item(item_id);
 
         // Check time
-        if (parameters.timer.needs_to_end()) {
+        if (deadline_checker.needs_to_end(instance.capacity() + 1)) {
             algorithm_formatter.end();
             return output;
         }
@@ -44,14 +99,14 @@ Output knapsacksolver::dynamic_programming_bellman_array(
             if (values[weight] < values[weight - item.weight] + item.profit)
                 values[weight] = values[weight - item.weight] + item.profit;
         }
+        if (output.statistics.enabled)
+            output.statistics.number_of_states_processed += number_of_cells(instance.capacity(), item);
 
         // Update value.
         if (output.value < values[instance.capacity()]) {
-            std::stringstream ss;
-            ss << "it " << item_id;
             algorithm_formatter.update_value(
                     values[instance.capacity()],
-                    ss.str());
+                    item_id);
         }
     }
 
@@ -64,6 +119,126 @@ Output knapsacksolver::dynamic_programming_bellman_array(
     return output;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+//////////////// dynamic_programming_bellman_array_capacities //////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+const DynamicProgrammingBellmanArrayCapacitiesOutput knapsacksolver::dynamic_programming_bellman_array_capacities(
+        const Instance& instance,
+        const DynamicProgrammingBellmanArrayCapacitiesParameters& parameters)
+{
+    DynamicProgrammingBellmanArrayCapacitiesOutput output(instance);
+    AlgorithmFormatter algorithm_formatter(parameters, output);
+    algorithm_formatter.start("Dynamic programming - Bellman - array - several capacities");
+    algorithm_formatter.print_header();
+
+    // Check capacities.
+    Weight maximum_capacity = 0;
+    for (Weight capacity: parameters.capacities) {
+        if (capacity < 0) {
+            throw std::invalid_argument(
+                    "The capacities must be non-negative.");
+        }
+        if (capacity > instance.capacity()) {
+            throw std::invalid_argument(
+                    "The capacities must be smaller than the capacity of the instance.");
+        }
+        maximum_capacity = std::max(maximum_capacity, capacity);
+    }
+    double memory = values_memory(maximum_capacity);
+    if (parameters.solutions)
+        memory += (double)instance.number_of_items() * (maximum_capacity + 1) / 8;
+    check_memory_limit(
+            parameters,
+            "dynamic-programming-bellman-array-capacities",
+            memory);
+
+    // Initialize memory table.
+    // 'decisions[item_id * (maximum_capacity + 1) + weight]' is 'true' iff
+    // item 'item_id' is packed in the optimal solution of capacity 'weight'
+    // using items '0' to 'item_id'.
+    std::vector<Profit> values(maximum_capacity + 1, 0);
+    std::vector<bool> decisions;
+    if (parameters.solutions)
+        decisions.resize(instance.number_of_items() * (maximum_capacity + 1), false);
+
+    // If the algorithm is interrupted, the values and the solutions are
+    // retrieved from the items processed so far.
+    DeadlineChecker deadline_checker(parameters, &algorithm_formatter);
+    ItemId number_of_processed_items = 0;
+    for (ItemId item_id = 0;
+            item_id < instance.number_of_items();
+            ++item_id) {
+        const Item& item = instance.item(item_id);
+
+        // Check time
+        if (deadline_checker.needs_to_end(maximum_capacity + 1))
+            break;
+        number_of_processed_items++;
+
+        // Update DP table
+        StateId offset = item_id * (maximum_capacity + 1);
+        for (Weight weight = maximum_capacity;
+                weight >= item.weight;
+                --weight) {
+            if (values[weight] < values[weight - item.weight] + item.profit) {
+                values[weight] = values[weight - item.weight] + item.profit;
+                if (parameters.solutions)
+                    decisions[offset + weight] = true;
+            }
+        }
+    }
+
+    // Retrieve optimal values.
+    output.values.resize(parameters.capacities.size());
+    for (std::size_t pos = 0; pos < parameters.capacities.size(); ++pos)
+        output.values[pos] = values[parameters.capacities[pos]];
+
+    // Retrieve optimal solutions.
+    if (parameters.solutions) {
+        output.solutions.reserve(parameters.capacities.size());
+        for (Weight capacity: parameters.capacities) {
+            Solution solution(instance);
+            Weight weight = capacity;
+            for (ItemId item_id = number_of_processed_items - 1;
+                    item_id >= 0;
+                    --item_id) {
+                if (decisions[item_id * (maximum_capacity + 1) + weight]) {
+                    weight -= instance.item(item_id).weight;
+                    solution.add(item_id);
+                }
+            }
+            output.solutions.push_back(solution);
+        }
+    }
+
+    for (std::size_t pos = 0; pos < parameters.capacities.size(); ++pos) {
+        if (parameters.capacities[pos] != instance.capacity())
+            continue;
+        if (parameters.solutions) {
+            // Update solution.
+            algorithm_formatter.update_solution(
+                    output.solutions[pos],
+                    "algorithm end (solution)");
+        } else {
+            // Update value.
+            algorithm_formatter.update_value(
+                    output.values[pos],
+                    "algorithm end (value)");
+        }
+        // Update bound.
+        if (!deadline_checker.ended()) {
+            algorithm_formatter.update_bound(
+                    output.value,
+                    "algorithm end (bound)");
+        }
+        break;
+    }
+
+    algorithm_formatter.end();
+    return output;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ////////////////// dynamic_programming_bellman_array_parallel //////////////////
 ////////////////////////////////////////////////////////////////////////////////
@@ -73,16 +248,21 @@ void dynamic_programming_bellman_array_parallel_worker(
         ItemPos item_id_start,
         ItemPos item_id_end,
         std::vector<Profit>::iterator values,
-        const Parameters& parameters)
+        const Parameters& parameters,
+        bool& interrupted)
 {
+    // Each thread has its own checker.
+    DeadlineChecker deadline_checker(parameters);
     for (ItemId item_id = item_id_start;
             item_id < item_id_end;
             ++item_id) {
         const Item& item = instance.item(item_id);
 
         // Check end.
-        if (parameters.timer.needs_to_end())
+        if (deadline_checker.needs_to_end(instance.capacity() + 1)) {
+            interrupted = true;
             return;
+        }
 
         for (Weight weight = instance.capacity();
                 weight >= item.weight;
@@ -97,6 +277,11 @@ Output knapsacksolver::dynamic_programming_bellman_array_parallel(
         const Instance& instance,
         const Parameters& parameters)
 {
+    // Each thread uses its own row of values. If both rows don't fit in the
+    // memory limit, fall back to the sequential algorithm.
+    if (!fits_memory_limit(parameters, 2 * values_memory(instance.capacity())))
+        return dynamic_programming_bellman_array(instance, parameters);
+
     Output output(instance);
     AlgorithmFormatter algorithm_formatter(parameters, output);
     algorithm_formatter.start("Dynamic programming - Bellman parallel - array - only value");
@@ -121,29 +306,44 @@ Output knapsacksolver::dynamic_programming_bellman_array_parallel(
     }
 
     // Partition items and solve both knapsacks
+    algorithm_formatter.start_phase("DynamicProgramming");
     ItemId item_id_middle = (instance.number_of_items() - 1) / 2 + 1;
     std::vector<Profit> values1(instance.capacity() + 1, 0);
+    bool interrupted_1 = false;
     std::thread thread(
             dynamic_programming_bellman_array_parallel_worker,
             std::ref(instance),
             0,
             item_id_middle,
             values1.begin(),
-            parameters);
+            std::ref(parameters),
+            std::ref(interrupted_1));
     std::vector<Profit> values2(instance.capacity() + 1, 0);
+    bool interrupted_2 = false;
     dynamic_programming_bellman_array_parallel_worker(
             std::ref(instance),
             item_id_middle,
             instance.number_of_items(),
             values2.begin(),
-            parameters);
+            parameters,
+            interrupted_2);
     thread.join();
-    if (parameters.timer.needs_to_end()) {
+    if (interrupted_1 || interrupted_2) {
         algorithm_formatter.end();
         return output;
     }
+    if (output.statistics.enabled) {
+        for (ItemId item_id = 0;
+                item_id < instance.number_of_items();
+                ++item_id) {
+            output.statistics.number_of_states_processed += number_of_cells(
+                    instance.capacity(),
+                    instance.item(item_id));
+        }
+    }
 
     // Compute optimal value.
+    algorithm_formatter.start_phase("Merge");
     Profit optimal_value = -1;
     for (Weight capacity = 0; capacity <= instance.capacity(); ++capacity) {
         Profit value = values1[capacity] + values2[instance.capacity() - capacity];
@@ -186,9 +386,9 @@ Profit dynamic_programming_bellman_rec_rec(
         std::vector<Profit>& values,
         ItemId item_id,
         Weight weight,
-        const Parameters& parameters)
+        DeadlineChecker& deadline_checker)
 {
-    if (parameters.timer.needs_to_end())
+    if (deadline_checker.needs_to_end())
         return -1;
     StateId state_id = compute_state_id(instance, item_id, weight);
     if (values[state_id] == -1) {
@@ -200,7 +400,7 @@ Profit dynamic_programming_bellman_rec_rec(
                     values,
                     item_id - 1,
                     weight,
-                    parameters);
+                    deadline_checker);
             values[state_id] = p1;
         } else {
             Profit profit_1 = dynamic_programming_bellman_rec_rec(
@@ -208,14 +408,14 @@ Profit dynamic_programming_bellman_rec_rec(
                     values,
                     item_id - 1,
                     weight,
-                    parameters);
+                    deadline_checker);
             Profit profit_2 = instance.item(item_id).profit
                 + dynamic_programming_bellman_rec_rec(
                     instance,
                     values,
                     item_id - 1,
                     weight - instance.item(item_id).weight,
-                    parameters);
+                    deadline_checker);
             values[state_id] = std::max(profit_1, profit_2);
         }
     }
@@ -226,6 +426,16 @@ Output knapsacksolver::dynamic_programming_bellman_rec(
         const Instance& instance,
         const Parameters& parameters)
 {
+    // The recursive algorithm stores the same table as the array algorithm
+    // storing all states, which falls back to leaner variants if it doesn't
+    // fit in the memory limit.
+    if (!fits_memory_limit(
+                parameters,
+                (double)(instance.number_of_items() + 1)
+                * values_memory(instance.capacity()))) {
+        return dynamic_programming_bellman_array_all(instance, parameters);
+    }
+
     Output output(instance);
     AlgorithmFormatter algorithm_formatter(parameters, output);
     algorithm_formatter.start("Dynamic programming - Bellman - recursive - only value");
@@ -236,13 +446,14 @@ Output knapsacksolver::dynamic_programming_bellman_rec(
     std::vector<Profit> values(values_size, -1);
 
     // Compute recursively
+    DeadlineChecker deadline_checker(parameters, &algorithm_formatter);
     Profit optimal_value = dynamic_programming_bellman_rec_rec(
             instance,
             values,
             instance.number_of_items() - 1,
             instance.capacity(),
-            parameters);
-    if (parameters.timer.needs_to_end()) {
+            deadline_checker);
+    if (deadline_checker.ended()) {
         algorithm_formatter.end();
         return output;
     }
@@ -285,6 +496,27 @@ Output knapsacksolver::dynamic_programming_bellman_array_all(
         const Instance& instance,
         const Parameters& parameters)
 {
+    // If the table doesn't fit in the memory limit, fall back to a single row
+    // of values with a table of one bit per decision, and then to the
+    // recursive scheme which only keeps two rows of values.
+    if (!fits_memory_limit(
+                parameters,
+                (double)(instance.number_of_items() + 1)
+                * values_memory(instance.capacity()))) {
+        double bit_table_memory = values_memory(instance.capacity())
+            + (double)instance.number_of_items() * (instance.capacity() + 1) / 8;
+        if (fits_memory_limit(parameters, bit_table_memory)) {
+            auto capacities_parameters = fallback_parameters<
+                DynamicProgrammingBellmanArrayCapacitiesParameters>(parameters);
+            capacities_parameters.capacities = {instance.capacity()};
+            capacities_parameters.solutions = true;
+            return dynamic_programming_bellman_array_capacities(
+                    instance,
+                    capacities_parameters);
+        }
+        return dynamic_programming_bellman_array_rec(instance, parameters);
+    }
+
     Output output(instance);
     AlgorithmFormatter algorithm_formatter(parameters, output);
     algorithm_formatter.start("Dynamic programming - Bellman - array - store all states");
@@ -295,6 +527,8 @@ Output knapsacksolver::dynamic_programming_bellman_array_all(
     std::vector<Profit> values(values_size);
 
     // Compute optimal value
+    algorithm_formatter.start_phase("DynamicProgramming");
+    DeadlineChecker deadline_checker(parameters, &algorithm_formatter);
     std::fill(values.begin(), values.begin() + instance.capacity() + 1, 0);
     for (ItemId item_id = 0;
             item_id < instance.number_of_items();
@@ -302,7 +536,7 @@ Output knapsacksolver::dynamic_programming_bellman_array_all(
         const Item& item = instance.item(item_id);
 
         // Check time
-        if (parameters.timer.needs_to_end()) {
+        if (deadline_checker.needs_to_end(instance.capacity() + 1)) {
             algorithm_formatter.end();
             return output;
         }
@@ -319,14 +553,14 @@ Output knapsacksolver::dynamic_programming_bellman_array_all(
             Profit profit_1 = values[compute_state_id(instance, item_id - 1, weight - item.weight)] + item.profit;
             values[compute_state_id(instance, item_id, weight)] = std::max(profit_0, profit_1);
         }
+        if (output.statistics.enabled)
+            output.statistics.number_of_states_processed += instance.capacity() + 1;
 
         // Update lower bound
         if (output.value < values[compute_state_id(instance, item_id, instance.capacity())]) {
-            std::stringstream ss;
-            ss << "it " << item_id;
             algorithm_formatter.update_value(
                     values[compute_state_id(instance, item_id, instance.capacity())],
-                    ss.str());
+                    item_id);
         }
     }
 
@@ -336,6 +570,7 @@ Output knapsacksolver::dynamic_programming_bellman_array_all(
             "algorithm end (bound)");
 
     // Retrieve optimal solution.
+    algorithm_formatter.start_phase("Reconstruction");
     Weight weight = instance.capacity();
     Solution solution(instance);
     for (ItemId item_id = instance.number_of_items() - 1;
@@ -356,13 +591,260 @@ Output knapsacksolver::dynamic_programming_bellman_array_all(
     return output;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+//////////////////// dynamic_programming_bellman_array_disk ////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+/**
+ * File storing the decisions of the Bellman array dynamic programming
+ * algorithm.
+ *
+ * The file is created with a unique name, failing rather than opening an
+ * existing file, and is removed as soon as it is created on POSIX systems and
+ * when it is closed on Windows, so that it doesn't outlive the algorithm even
+ * if the process is killed.
+ */
+class DecisionFile
+{
+
+public:
+
+    DecisionFile(const std::string& directory)
+    {
+        if (directory.empty()) {
+            path_ = "temporary file";
+            file_ = std::tmpfile();
+        } else {
+            file_ = create(directory);
+        }
+        if (file_ == nullptr) {
+            throw std::runtime_error(
+                    "Unable to create the decision file \"" + path_ + "\".");
+        }
+    }
+
+    ~DecisionFile()
+    {
+        std::fclose(file_);
+    }
+
+    DecisionFile(const DecisionFile&) = delete;
+    DecisionFile& operator=(const DecisionFile&) = delete;
+
+    /** Append words at the end of the file. */
+    void write(const std::vector<uint64_t>& words)
+    {
+        if (std::fwrite(words.data(), sizeof(uint64_t), words.size(), file_)
+                != words.size()) {
+            throw std::runtime_error(
+                    "Unable to write the decision file \"" + path_ + "\".");
+        }
+        size_ += words.size() * sizeof(uint64_t);
+    }
+
+    /** Read the word at a given offset, in bytes. */
+    uint64_t read(int64_t offset)
+    {
+        if (!flushed_) {
+            std::fflush(file_);
+            flushed_ = true;
+        }
+        uint64_t word = 0;
+#ifdef _WIN32
+        int seek_status = _fseeki64(file_, offset, SEEK_SET);
+#else
+        int seek_status = fseeko(file_, (off_t)offset, SEEK_SET);
+#endif
+        if (seek_status != 0
+                || std::fread(&word, sizeof(uint64_t), 1, file_) != 1) {
+            throw std::runtime_error(
+                    "Unable to read the decision file \"" + path_ + "\".");
+        }
+        return word;
+    }
+
+    /** Get the size of the file, in bytes. */
+    int64_t size() const { return size_; }
+
+private:
+
+    /**
+     * Create a new file with a unique name in a directory; return 'nullptr'
+     * on failure.
+     */
+    std::FILE* create(const std::string& directory)
+    {
+#ifdef _WIN32
+        std::random_device random_device;
+        for (int attempt = 0; attempt < 100; ++attempt) {
+            path_ = directory + "\\knapsacksolver_decisions_"
+                + std::to_string(random_device());
+            int file_descriptor = _open(
+                    path_.c_str(),
+                    _O_CREAT | _O_EXCL | _O_RDWR | _O_BINARY | _O_TEMPORARY,
+                    _S_IREAD | _S_IWRITE);
+            if (file_descriptor >= 0)
+                return _fdopen(file_descriptor, "w+b");
+            if (errno != EEXIST)
+                return nullptr;
+        }
+        return nullptr;
+#else
+        path_ = directory + "/knapsacksolver_decisions_XXXXXX";
+        std::vector<char> path(path_.begin(), path_.end());
+        path.push_back('\0');
+        int file_descriptor = mkstemp(path.data());
+        path_ = path.data();
+        if (file_descriptor < 0)
+            return nullptr;
+        // Only the file descriptor refers to the file from now on.
+        unlink(path.data());
+        std::FILE* file = fdopen(file_descriptor, "w+b");
+        if (file == nullptr)
+            close(file_descriptor);
+        return file;
+#endif
+    }
+
+    /** Path of the file, for the error messages. */
+    std::string path_;
+
+    /** File. */
+    std::FILE* file_ = nullptr;
+
+    /** Size of the file, in bytes. */
+    int64_t size_ = 0;
+
+    /** 'true' iff the file has been flushed since the last write. */
+    bool flushed_ = false;
+
+};
+
+}
+
+const DynamicProgrammingBellmanArrayDiskOutput knapsacksolver::dynamic_programming_bellman_array_disk(
+        const Instance& instance,
+        const DynamicProgrammingBellmanArrayDiskParameters& parameters)
+{
+    DynamicProgrammingBellmanArrayDiskOutput output(instance);
+    AlgorithmFormatter algorithm_formatter(parameters, output);
+    algorithm_formatter.start("Dynamic programming - Bellman - array - decisions on disk");
+    algorithm_formatter.print_header();
+
+    // Check trivial cases.
+    if (instance.total_item_weight() <= instance.capacity()) {
+        Solution solution(instance);
+        solution.fill();
+
+        // Update solution.
+        algorithm_formatter.update_solution(
+                solution,
+                "all items fit (solution)");
+        // Update bound.
+        algorithm_formatter.update_bound(
+                output.value,
+                "all items fit (bound)");
+
+        algorithm_formatter.end();
+        return output;
+    }
+
+    check_memory_limit(
+            parameters,
+            "dynamic-programming-bellman-array-disk",
+            values_memory(instance.capacity())
+            + (double)instance.number_of_items() * sizeof(int64_t)
+            + (double)(instance.capacity() / 64 + 1) * sizeof(uint64_t));
+
+    DecisionFile decision_file(parameters.decision_directory);
+
+    // Offset in the decision file of the row of each item; -1 if the item
+    // doesn't fit.
+    std::vector<int64_t> offsets(instance.number_of_items(), -1);
+    std::vector<Profit> values(instance.capacity() + 1, 0);
+    std::vector<uint64_t> decisions;
+
+    // Compute optimal value
+    DeadlineChecker deadline_checker(parameters, &algorithm_formatter);
+    for (ItemId item_id = 0;
+            item_id < instance.number_of_items();
+            ++item_id) {
+        const Item& item = instance.item(item_id);
+
+        // Check time
+        if (deadline_checker.needs_to_end(instance.capacity() + 1)) {
+            output.decision_file_size = decision_file.size();
+            algorithm_formatter.end();
+            return output;
+        }
+
+        if (item.weight > instance.capacity())
+            continue;
+
+        // The row only covers the words of the capacities greater than or
+        // equal to the weight of the item.
+        Weight first_word_pos = item.weight >> 6;
+        decisions.assign((instance.capacity() >> 6) - first_word_pos + 1, 0);
+        for (Weight weight = instance.capacity();
+                weight >= item.weight;
+                weight--) {
+            Profit profit = values[weight - item.weight] + item.profit;
+            if (values[weight] < profit) {
+                values[weight] = profit;
+                decisions[(weight >> 6) - first_word_pos] |= (uint64_t)1 << (weight & 63);
+            }
+        }
+        offsets[item_id] = decision_file.size();
+        decision_file.write(decisions);
+
+        // Update lower bound
+        if (output.value < values[instance.capacity()]) {
+            algorithm_formatter.update_value(
+                    values[instance.capacity()],
+                    item_id);
+        }
+    }
+    output.decision_file_size = decision_file.size();
+
+    // Update upper bound
+    algorithm_formatter.update_bound(
+            output.value,
+            "algorithm end (bound)");
+
+    // Retrieve optimal solution by reading the decisions backward.
+    Weight weight = instance.capacity();
+    Solution solution(instance);
+    for (ItemId item_id = instance.number_of_items() - 1;
+            item_id >= 0;
+            --item_id) {
+        const Item& item = instance.item(item_id);
+        if (offsets[item_id] == -1 || weight < item.weight)
+            continue;
+        int64_t offset = offsets[item_id]
+            + ((weight >> 6) - (item.weight >> 6)) * (int64_t)sizeof(uint64_t);
+        if ((decision_file.read(offset) >> (weight & 63)) & 1) {
+            weight -= item.weight;
+            solution.add(item_id);
+        }
+    }
+    algorithm_formatter.update_solution(
+            solution,
+            "algorithm end (solution)");
+
+    algorithm_formatter.end();
+    return output;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 //////////////////// dynamic_programming_bellman_array_one /////////////////////
 ////////////////////////////////////////////////////////////////////////////////
 
 const DynamicProgrammingBellmanArrayOneOutput knapsacksolver::dynamic_programming_bellman_array_one(
         const Instance& instance,
-        const Parameters& parameters)
+        const DynamicProgrammingBellmanArrayOneParameters& parameters)
 {
     DynamicProgrammingBellmanArrayOneOutput output(instance);
     AlgorithmFormatter algorithm_formatter(parameters, output);
@@ -388,22 +870,92 @@ const DynamicProgrammingBellmanArrayOneOutput knapsacksolver::dynamic_programmin
     }
 
     // Initialize memory table.
+    check_memory_limit(
+            parameters,
+            "dynamic-programming-bellman-array-one",
+            values_memory(instance.capacity()));
     std::vector<Profit> values(instance.capacity() + 1);
 
+    DeadlineChecker deadline_checker(parameters, &algorithm_formatter);
     Profit optimal_value = -1;
     Profit optimal_value_local = -1;
     Solution solution(instance);
     ItemId last_item_id = instance.number_of_items() - 1;
     Weight remaining_capacity = instance.capacity();
+    ItemId new_last_item_id = -1;
+
+    // The checkpoint stores the state before processing item 'item_id' of
+    // the current iteration.
+    const std::string checkpoint_algorithm = "dynamic-programming-bellman-array-one";
+    auto write_checkpoint = [&](ItemId item_id)
+    {
+        CheckpointWriter writer(
+                parameters.checkpoint_path,
+                checkpoint_algorithm,
+                instance);
+        writer.write(output.value);
+        writer.write(output.bound);
+        writer.write(output.number_of_iterations);
+        writer.write(optimal_value);
+        writer.write(optimal_value_local);
+        writer.write(solution);
+        writer.write(last_item_id);
+        writer.write(remaining_capacity);
+        writer.write(new_last_item_id);
+        writer.write(item_id);
+        writer.write(values);
+        writer.commit();
+    };
+
+    ItemId first_item_id = 0;
+    bool resumed = false;
+    if (parameters.resume
+            && !parameters.checkpoint_path.empty()
+            && checkpoint_exists(parameters.checkpoint_path)) {
+        CheckpointReader reader(
+                parameters.checkpoint_path,
+                checkpoint_algorithm,
+                instance);
+        Profit value = 0;
+        reader.read(value);
+        Profit bound = 0;
+        reader.read(bound);
+        reader.read(output.number_of_iterations);
+        reader.read(optimal_value);
+        reader.read(optimal_value_local);
+        reader.read(solution);
+        reader.read(last_item_id);
+        reader.read(remaining_capacity);
+        reader.read(new_last_item_id);
+        reader.read(first_item_id);
+        reader.read(values, instance.capacity() + 1);
+        if ((Weight)values.size() != instance.capacity() + 1) {
+            throw std::invalid_argument(
+                    "The checkpoint \"" + parameters.checkpoint_path
+                    + "\" is corrupted.");
+        }
+        algorithm_formatter.update_value(value, "checkpoint (value)");
+        algorithm_formatter.update_bound(bound, "checkpoint (bound)");
+        resumed = true;
+    }
+    double next_checkpoint_time = parameters.timer.elapsed_time()
+        + parameters.checkpoint_interval;
+    Counter checkpoint_number_of_checks = deadline_checker.number_of_checks();
+
+    algorithm_formatter.start_phase("DynamicProgramming");
     while (solution.profit() != optimal_value) {
-        output.number_of_iterations++;
 
         // Initialization
-        std::fill(values.begin(), values.end(), 0);
-        ItemId new_last_item_id = -1;
+        if (!resumed) {
+            output.number_of_iterations++;
+            std::fill(values.begin(), values.end(), 0);
+            new_last_item_id = -1;
+            first_item_id = 0;
+        }
+        resumed = false;
 
         // Recursion
-        for (ItemId item_id = 0;
+        for (ItemId item_id = first_item_id;
                 item_id <= last_item_id;
                 ++item_id) {
             const Item& item = instance.item(item_id);
@@ -412,11 +964,25 @@ const DynamicProgrammingBellmanArrayOneOutput knapsacksolver::dynamic_programmin
                 continue;
 
             // Check time
-            if (parameters.timer.needs_to_end()) {
+            if (deadline_checker.needs_to_end(remaining_capacity + 1)) {
+                if (!parameters.checkpoint_path.empty())
+                    write_checkpoint(item_id);
                 algorithm_formatter.end();
                 return output;
             }
 
+            // Write checkpoint. The clock is only read when the deadline
+            // checker reads it.
+            if (!parameters.checkpoint_path.empty()
+                    && (parameters.checkpoint_interval <= 0
+                        || (checkpoint_number_of_checks != deadline_checker.number_of_checks()
+                            && parameters.timer.elapsed_time() >= next_checkpoint_time))) {
+                write_checkpoint(item_id);
+                next_checkpoint_time = parameters.timer.elapsed_time()
+                    + parameters.checkpoint_interval;
+            }
+            checkpoint_number_of_checks = deadline_checker.number_of_checks();
+
             if (values[remaining_capacity - item.weight] + item.profit > values[remaining_capacity]) {
                 values[remaining_capacity] = values[remaining_capacity - item.weight] + item.profit;
                 new_last_item_id = item_id;
@@ -432,12 +998,14 @@ const DynamicProgrammingBellmanArrayOneOutput knapsacksolver::dynamic_programmin
                 if (values[weight - item.weight] + item.profit > values[weight])
                     values[weight] = values[weight - item.weight] + item.profit;
             }
+            if (output.statistics.enabled)
+                output.statistics.number_of_states_processed += number_of_cells(remaining_capacity, item);
 
             // Update value.
             if (output.value < values[remaining_capacity]) {
-                std::stringstream ss;
-                ss << "it " << item_id;
-                algorithm_formatter.update_value(values[remaining_capacity], ss.str());
+                algorithm_formatter.update_value(
+                        values[remaining_capacity],
+                        item_id);
             }
         }
 end:
@@ -504,15 +1072,22 @@ const DynamicProgrammingBellmanArrayPartOutput knapsacksolver::dynamic_programmi
     }
 
     // Initialize memory table
+    check_memory_limit(
+            parameters,
+            "dynamic-programming-bellman-array-part",
+            values_memory(instance.capacity())
+            + (double)(instance.capacity() + 1) * sizeof(optimizationtools::PartialSet));
     std::vector<Profit> values(instance.capacity() + 1);
     std::vector<optimizationtools::PartialSet> partial_solutions(instance.capacity() + 1);
 
+    DeadlineChecker deadline_checker(parameters, &algorithm_formatter);
     Profit optimal_value = -1;
     Profit optimal_value_local = -1;
     Weight remaining_capacity = instance.capacity();
     Solution solution(instance);
     ItemId first_item_id = 0;
     ItemId last_item_id = instance.number_of_items() - 1;
+    algorithm_formatter.start_phase("DynamicProgramming");
     while (solution.profit() != optimal_value) {
         output.number_of_iterations++;
 
@@ -539,7 +1114,7 @@ const DynamicProgrammingBellmanArrayPartOutput knapsacksolver::dynamic_programmi
             const Item& item = instance.item(item_id);
 
             // Check end.
-            if (parameters.timer.needs_to_end()) {
+            if (deadline_checker.needs_to_end(remaining_capacity + 1)) {
                 algorithm_formatter.end();
                 return output;
             }
@@ -560,14 +1135,14 @@ const DynamicProgrammingBellmanArrayPartOutput knapsacksolver::dynamic_programmi
                     }
                 }
             }
+            if (output.statistics.enabled)
+                output.statistics.number_of_states_processed += number_of_cells(remaining_capacity, item);
 
             // Update lower bound
             if (output.value < values[remaining_capacity]) {
-                std::stringstream ss;
-                ss << "it " << item_id;
                 algorithm_formatter.update_value(
                         values[remaining_capacity],
-                        ss.str());
+                        item_id);
             }
         }
 end:
@@ -647,14 +1222,14 @@ struct RecData
 
 std::vector<Profit> opts_dynamic_programming_bellman_array(
         const Instance& instance,
-        const Parameters& parameters,
+        DeadlineChecker& deadline_checker,
         ItemPos item_id_1,
         ItemPos item_id_2,
         Weight capacity)
 {
     std::vector<Profit> values(capacity + 1, 0);
     for (ItemId item_id = item_id_1; item_id < item_id_2; ++item_id) {
-        if (parameters.timer.needs_to_end())
+        if (deadline_checker.needs_to_end(capacity + 1))
             break;
         const Item& item = instance.item(item_id);
         for (Weight weight = capacity; weight >= item.weight; weight--)
@@ -666,7 +1241,7 @@ std::vector<Profit> opts_dynamic_programming_bellman_array(
 
 void dynamic_programming_bellman_array_rec_rec(
         const Instance& instance,
-        const Parameters& parameters,
+        DeadlineChecker& deadline_checker,
         Solution& solution,
         ItemPos item_id_1,
         ItemPos item_id_2,
@@ -676,13 +1251,13 @@ void dynamic_programming_bellman_array_rec_rec(
 
     auto values_1 = opts_dynamic_programming_bellman_array(
             instance,
-            parameters,
+            deadline_checker,
             item_id_1,
             item_id_middle,
             capacity);
     auto values_2 = opts_dynamic_programming_bellman_array(
             instance,
-            parameters,
+            deadline_checker,
             item_id_middle,
             item_id_2,
             capacity);
@@ -707,10 +1282,15 @@ void dynamic_programming_bellman_array_rec_rec(
         if (values_2[optimal_capacity_2] == instance.item(item_id_middle).profit)
             solution.add(item_id_middle);
 
+    // Release the rows before the recursive calls so that at most two rows
+    // are allocated at the same time.
+    std::vector<Profit>().swap(values_1);
+    std::vector<Profit>().swap(values_2);
+
     if (item_id_1 != item_id_middle - 1) {
         dynamic_programming_bellman_array_rec_rec(
                 instance,
-                parameters,
+                deadline_checker,
                 solution,
                 item_id_1,
                 item_id_middle,
@@ -719,7 +1299,7 @@ void dynamic_programming_bellman_array_rec_rec(
     if (item_id_middle != item_id_2 - 1) {
         dynamic_programming_bellman_array_rec_rec(
                 instance,
-                parameters,
+                deadline_checker,
                 solution,
                 item_id_middle,
                 item_id_2,
@@ -756,15 +1336,20 @@ Output knapsacksolver::dynamic_programming_bellman_array_rec(
     }
 
     // Start recursion.
+    check_memory_limit(
+            parameters,
+            "dynamic-programming-bellman-array-rec",
+            2 * values_memory(instance.capacity()));
+    DeadlineChecker deadline_checker(parameters, &algorithm_formatter);
     Solution solution(instance);
     dynamic_programming_bellman_array_rec_rec(
             instance,
-            parameters,
+            deadline_checker,
             solution,
             0,
             instance.number_of_items(),
             instance.capacity());
-    if (parameters.timer.needs_to_end()) {
+    if (deadline_checker.ended()) {
         algorithm_formatter.end();
         return output;
     }
@@ -833,6 +1418,7 @@ Output knapsacksolver::dynamic_programming_bellman_list(
     }
 
     // Find break item.
+    algorithm_formatter.start_phase("Sort");
     std::unique_ptr<PartialSort> partial_sort;
     std::unique_ptr<FullSort> full_sort;
     if (parameters.sort) {
@@ -842,8 +1428,10 @@ Output knapsacksolver::dynamic_programming_bellman_list(
     }
 
     // Get the greedy solution.
+    algorithm_formatter.start_phase("Greedy");
     GreedyParameters greedy_parameters;
     greedy_parameters.timer = parameters.timer;
+    greedy_parameters.stop = parameters.stop;
     greedy_parameters.verbosity_level = 0;
     if (parameters.sort) {
         greedy_parameters.full_sort = full_sort.get();
@@ -858,8 +1446,10 @@ Output knapsacksolver::dynamic_programming_bellman_list(
             "greedy");
 
     // Compute an initial bound.
+    algorithm_formatter.start_phase("DantzigUpperBound");
     UpperBoundDantzigParameters upper_bound_dantzig_parameters;
     upper_bound_dantzig_parameters.timer = parameters.timer;
+    upper_bound_dantzig_parameters.stop = parameters.stop;
     upper_bound_dantzig_parameters.verbosity_level = 0;
     if (parameters.sort) {
         upper_bound_dantzig_parameters.full_sort = full_sort.get();
@@ -876,6 +1466,8 @@ Output knapsacksolver::dynamic_programming_bellman_list(
             "dantzig upper bound");
 
     // Main recursion.
+    algorithm_formatter.start_phase("DynamicProgramming");
+    DeadlineChecker deadline_checker(parameters, &algorithm_formatter);
     std::vector<BellmanState> l0{{0, 0}};
     for (ItemPos item_id = 0;
             item_id < instance.number_of_items() && !l0.empty();
@@ -890,12 +1482,22 @@ Output knapsacksolver::dynamic_programming_bellman_list(
             full_sort->item_id(item_id + 1);
 
         // Check end.
-        if (parameters.timer.needs_to_end()) {
+        if (deadline_checker.needs_to_end(l0.size())) {
             algorithm_formatter.end();
             return output;
         }
 
+        // The next list contains at most twice as many states as the current
+        // one.
+        check_memory_limit(
+                parameters,
+                "dynamic-programming-bellman-list",
+                3.0 * l0.size() * sizeof(BellmanState));
+
         Profit upper_bound_it = -1;
+        Counter number_of_states_pruned_by_weight = 0;
+        Counter number_of_states_pruned_by_bound = 0;
+        Counter number_of_states_pruned_by_dominance = 0;
         std::vector<BellmanState> l;
         std::vector<BellmanState>::iterator it = l0.begin();
         std::vector<BellmanState>::iterator it1 = l0.begin();
@@ -906,8 +1508,12 @@ Output knapsacksolver::dynamic_programming_bellman_list(
                 BellmanState s1{it1->weight + item.weight, it1->profit + item.profit};
 
                 // Check capacity.
-                if (s1.weight > instance.capacity())
+                if (s1.weight > instance.capacity()) {
+                    // The remaining states are too heavy as well.
+                    number_of_states_pruned_by_weight
+                        += (l0.end() - it1) + (l0.end() - it);
                     break;
+                }
 
                 Profit upper_bound_curr = upper_bound(
                         instance,
@@ -915,14 +1521,15 @@ Output knapsacksolver::dynamic_programming_bellman_list(
                         s1.weight,
                         bound_item_id);
 
-                if (upper_bound_curr > output.value
-                        && (l.empty() || s1.profit > l.back().profit)) {
+                if (upper_bound_curr <= output.value) {
+                    number_of_states_pruned_by_bound++;
+                } else if (!l.empty() && s1.profit <= l.back().profit) {
+                    number_of_states_pruned_by_dominance++;
+                } else {
 
                     // Update value.
                     if (output.value < s1.profit) {
-                        std::stringstream ss;
-                        ss << "it " << item_id;
-                        algorithm_formatter.update_value(s1.profit, ss.str());
+                        algorithm_formatter.update_value(s1.profit, item_id);
                     }
 
                     // Update current bound.
@@ -930,6 +1537,7 @@ Output knapsacksolver::dynamic_programming_bellman_list(
                         upper_bound_it = upper_bound_curr;
 
                     if (!l.empty() && s1.weight == l.back().weight) {
+                        number_of_states_pruned_by_dominance++;
                         l.back() = s1;
                     } else {
                         l.push_back(s1);
@@ -945,14 +1553,18 @@ Output knapsacksolver::dynamic_programming_bellman_list(
                         it->weight,
                         bound_item_id);
 
-                if (upper_bound_curr > output.value
-                        && (l.empty() || it->profit > l.back().profit)) {
+                if (upper_bound_curr <= output.value) {
+                    number_of_states_pruned_by_bound++;
+                } else if (!l.empty() && it->profit <= l.back().profit) {
+                    number_of_states_pruned_by_dominance++;
+                } else {
 
                     // Update current bound.
                     if (upper_bound_it < upper_bound_curr)
                         upper_bound_it = upper_bound_curr;
 
                     if (!l.empty() && it->weight == l.back().weight) {
+                        number_of_states_pruned_by_dominance++;
                         l.back() = *it;
                     } else {
                         l.push_back(*it);
@@ -961,14 +1573,21 @@ Output knapsacksolver::dynamic_programming_bellman_list(
                 ++it;
             }
         }
+        if (output.statistics.enabled) {
+            output.statistics.number_of_states_pruned_by_weight += number_of_states_pruned_by_weight;
+            output.statistics.number_of_states_pruned_by_bound += number_of_states_pruned_by_bound;
+            output.statistics.number_of_states_pruned_by_dominance += number_of_states_pruned_by_dominance;
+            output.statistics.state_list_sizes.push_back(l.size());
+            output.statistics.number_of_states_processed += l0.size();
+            output.statistics.update_peak_memory(
+                    (l0.capacity() + l.capacity()) * sizeof(BellmanState));
+        }
         l0 = std::move(l);
 
         // Update bound.
         upper_bound_it = std::max(upper_bound_it, output.value);
         if (output.bound > upper_bound_it) {
-            std::stringstream ss;
-            ss << "it " << item_id;
-            algorithm_formatter.update_bound(upper_bound_it, ss.str());
+            algorithm_formatter.update_bound(upper_bound_it, item_id);
         }
     }
     // Update bound.
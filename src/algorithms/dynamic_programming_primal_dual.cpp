@@ -2,7 +2,9 @@
 
 #include "knapsacksolver/instance_builder.hpp"
 #include "knapsacksolver/algorithm_formatter.hpp"
+#include "knapsacksolver/deadline_checker.hpp"
 #include "knapsacksolver/sort.hpp"
+#include "knapsacksolver/checkpoint.hpp"
 #include "knapsacksolver/upper_bound.hpp"
 #include "knapsacksolver/algorithms/upper_bound_dantzig.hpp"
 #include "knapsacksolver/algorithms/greedy.hpp"
@@ -26,6 +28,23 @@ struct DynamicProgrammingPrimalDualState
     optimizationtools::PartialSet partial_solution;
 };
 
+}
+
+struct knapsacksolver::DynamicProgrammingPrimalDualWorkspaceData
+{
+    /** Lists of states. */
+    std::vector<DynamicProgrammingPrimalDualState> l0;
+    std::vector<DynamicProgrammingPrimalDualState> l;
+};
+
+DynamicProgrammingPrimalDualWorkspace::DynamicProgrammingPrimalDualWorkspace():
+    data(new DynamicProgrammingPrimalDualWorkspaceData()) { }
+
+DynamicProgrammingPrimalDualWorkspace::~DynamicProgrammingPrimalDualWorkspace() { }
+
+namespace
+{
+
 struct DynamicProgrammingPrimalDualInternalData
 {
     DynamicProgrammingPrimalDualInternalData(
@@ -40,7 +59,25 @@ struct DynamicProgrammingPrimalDualInternalData
         partial_sort(instance),
         partial_solution_factory(
                 instance.number_of_items(),
-                parameters.partial_solution_size) { }
+                parameters.partial_solution_size)
+    {
+        // Take the lists of states of the workspace to reuse their memory.
+        if (parameters.workspace != nullptr) {
+            l0.swap(parameters.workspace->data->l0);
+            l.swap(parameters.workspace->data->l);
+            l0.clear();
+            l.clear();
+        }
+    }
+
+    ~DynamicProgrammingPrimalDualInternalData()
+    {
+        // Give the lists of states back to the workspace.
+        if (parameters.workspace != nullptr) {
+            l0.swap(parameters.workspace->data->l0);
+            l.swap(parameters.workspace->data->l);
+        }
+    }
 
     /** Instance. */
     const Instance& instance;
@@ -60,6 +97,14 @@ struct DynamicProgrammingPrimalDualInternalData
     /** Partial solution factory. */
     optimizationtools::PartialSetFactory partial_solution_factory;
 
+    /**
+     * Elements added to the partial solution factory, in order.
+     *
+     * They are replayed when resuming from a checkpoint so that the elements
+     * get the same positions in the partial solutions.
+     */
+    std::vector<ItemPos> partial_solution_factory_elements;
+
     ItemPos s;
 
     ItemPos t;
@@ -83,9 +128,43 @@ struct DynamicProgrammingPrimalDualInternalData
     DynamicProgrammingPrimalDualState best_state;
 };
 
+/**
+ * Throw a 'MemoryLimitExceeded' if the next list of states might not fit in
+ * the memory limit.
+ *
+ * The next list contains at most twice as many states as the current one.
+ */
+void check_states_memory(const DynamicProgrammingPrimalDualInternalData& data)
+{
+    check_memory_limit(
+            data.parameters,
+            "dynamic-programming-primal-dual",
+            3.0 * data.l0.size() * sizeof(DynamicProgrammingPrimalDualState)
+            + (double)data.instance.number_of_items() * sizeof(ItemId));
+}
+
+void update_statistics(
+        DynamicProgrammingPrimalDualInternalData& data,
+        Counter number_of_states_pruned_by_weight,
+        Counter number_of_states_pruned_by_bound,
+        Counter number_of_states_pruned_by_dominance)
+{
+    Statistics& statistics = data.output.statistics;
+    statistics.number_of_states_pruned_by_weight += number_of_states_pruned_by_weight;
+    statistics.number_of_states_pruned_by_bound += number_of_states_pruned_by_bound;
+    statistics.number_of_states_pruned_by_dominance += number_of_states_pruned_by_dominance;
+    statistics.state_list_sizes.push_back(data.l0.size());
+    // The lists have been swapped, 'data.l' contains the processed states.
+    statistics.number_of_states_processed += data.l.size();
+    statistics.update_peak_memory(
+            (data.l0.capacity() + data.l.capacity()) * sizeof(DynamicProgrammingPrimalDualState)
+            + data.instance.number_of_items() * sizeof(ItemId));
+}
+
 void add_item(DynamicProgrammingPrimalDualInternalData& data)
 {
     const Instance& instance = data.instance;
+    check_states_memory(data);
     ItemId item_id = data.partial_sort.item_id(data.t);
     const Item& item = instance.item(item_id);
     //std::cout << "add_item"
@@ -94,6 +173,7 @@ void add_item(DynamicProgrammingPrimalDualInternalData& data)
     //    << std::endl;
 
     data.partial_solution_factory.add_element_to_factory(data.t);
+    data.partial_solution_factory_elements.push_back(data.t);
     data.best_state.partial_solution = data.partial_solution_factory.remove(
             data.best_state.partial_solution,
             data.t);
@@ -106,6 +186,9 @@ void add_item(DynamicProgrammingPrimalDualInternalData& data)
         - data.partial_sort.mandatory_items().weight();
 
     data.l.clear();
+    Counter number_of_states_pruned_by_weight = 0;
+    Counter number_of_states_pruned_by_bound = 0;
+    Counter number_of_states_pruned_by_dominance = 0;
     std::vector<DynamicProgrammingPrimalDualState>::iterator it = data.l0.begin();
     std::vector<DynamicProgrammingPrimalDualState>::iterator it1 = data.l0.begin();
     Profit upper_bound_it = 0;
@@ -115,6 +198,7 @@ void add_item(DynamicProgrammingPrimalDualInternalData& data)
             // Check state weight.
             Weight weight = it1->weight + item.weight;
             if (weight > maximum_weight) {
+                number_of_states_pruned_by_weight++;
                 it1++;
                 continue;
             }
@@ -122,6 +206,7 @@ void add_item(DynamicProgrammingPrimalDualInternalData& data)
             Profit profit = it1->profit + item.profit;
             if (!data.l.empty()
                     && profit <= data.l.back().profit) {
+                number_of_states_pruned_by_dominance++;
                 it1++;
                 continue;
             }
@@ -132,6 +217,7 @@ void add_item(DynamicProgrammingPrimalDualInternalData& data)
                 upper_bound_reverse(instance, profit, weight, sx);
             upper_bound_it = std::max(upper_bound_it, upper_bound_curr);
             if (upper_bound_curr <= data.output.value) {
+                number_of_states_pruned_by_bound++;
                 it1++;
                 continue;
             }
@@ -144,13 +230,15 @@ void add_item(DynamicProgrammingPrimalDualInternalData& data)
             // Update lower bound
             if (state.weight <= instance.capacity()
                     && state.profit > data.output.value) {
-                std::stringstream ss;
-                ss << "it " << data.t - data.s << " (value)";
-                data.algorithm_formatter.update_value(state.profit, ss.str());
+                data.algorithm_formatter.update_value(
+                        state.profit,
+                        data.t - data.s,
+                        " (value)");
                 data.best_state = state;
             }
 
             if (!data.l.empty() && state.weight == data.l.back().weight) {
+                number_of_states_pruned_by_dominance++;
                 data.l.back() = state;
             } else {
                 data.l.push_back(state);
@@ -161,11 +249,13 @@ void add_item(DynamicProgrammingPrimalDualInternalData& data)
 
             // Check state weight.
             if (it->weight > maximum_weight) {
+                number_of_states_pruned_by_weight++;
                 it++;
                 continue;
             }
 
             if (!data.l.empty() && it->profit <= data.l.back().profit) {
+                number_of_states_pruned_by_dominance++;
                 it++;
                 continue;
             }
@@ -176,12 +266,14 @@ void add_item(DynamicProgrammingPrimalDualInternalData& data)
                 upper_bound_reverse(instance, it->profit, it->weight, sx);
             upper_bound_it = std::max(upper_bound_it, upper_bound_curr);
             if (upper_bound_curr <= data.output.value) {
+                number_of_states_pruned_by_bound++;
                 it++;
                 continue;
             }
 
             it->partial_solution = data.partial_solution_factory.remove(it->partial_solution, data.t);
             if (!data.l.empty() && it->weight == data.l.back().weight) {
+                number_of_states_pruned_by_dominance++;
                 data.l.back() = *it;
             } else {
                 data.l.push_back(*it);
@@ -192,17 +284,27 @@ void add_item(DynamicProgrammingPrimalDualInternalData& data)
 
     upper_bound_it = std::max(upper_bound_it, data.output.value);
     if (data.output.bound > upper_bound_it) {
-        std::stringstream ss;
-        ss << "it " << data.t - data.s << " (bound)";
-        data.algorithm_formatter.update_bound(upper_bound_it, ss.str());
+        data.algorithm_formatter.update_bound(
+                upper_bound_it,
+                data.t - data.s,
+                " (bound)");
     }
 
     data.l0.swap(data.l);
+
+    if (data.output.statistics.enabled) {
+        update_statistics(
+                data,
+                number_of_states_pruned_by_weight,
+                number_of_states_pruned_by_bound,
+                number_of_states_pruned_by_dominance);
+    }
 }
 
 void remove_item(DynamicProgrammingPrimalDualInternalData& data)
 {
     const Instance& instance = data.instance;
+    check_states_memory(data);
     ItemId item_id = data.partial_sort.item_id(data.s);
     const Item& item = instance.item(item_id);
     //std::cout << "remove_item"
@@ -211,6 +313,7 @@ void remove_item(DynamicProgrammingPrimalDualInternalData& data)
     //    << std::endl;
 
     data.partial_solution_factory.add_element_to_factory(data.s);
+    data.partial_solution_factory_elements.push_back(data.s);
     data.best_state.partial_solution = data.partial_solution_factory.add(
             data.best_state.partial_solution,
             data.s);
@@ -224,6 +327,9 @@ void remove_item(DynamicProgrammingPrimalDualInternalData& data)
         - data.partial_sort.mandatory_items().weight();
 
     data.l.clear();
+    Counter number_of_states_pruned_by_weight = 0;
+    Counter number_of_states_pruned_by_bound = 0;
+    Counter number_of_states_pruned_by_dominance = 0;
     std::vector<DynamicProgrammingPrimalDualState>::iterator it = data.l0.begin();
     std::vector<DynamicProgrammingPrimalDualState>::iterator it1 = data.l0.begin();
     Profit upper_bound_it = 0;
@@ -232,11 +338,13 @@ void remove_item(DynamicProgrammingPrimalDualInternalData& data)
 
             // Check state weight.
             if (it->weight > maximum_weight) {
+                number_of_states_pruned_by_weight++;
                 it++;
                 continue;
             }
 
             if (!data.l.empty() && it->profit <= data.l.back().profit) {
+                number_of_states_pruned_by_dominance++;
                 it++;
                 continue;
             }
@@ -246,12 +354,14 @@ void remove_item(DynamicProgrammingPrimalDualInternalData& data)
                 upper_bound_reverse(instance, it->profit, it->weight, sx);
             upper_bound_it = std::max(upper_bound_it, upper_bound_curr);
             if (upper_bound_curr <= data.output.value) {
+                number_of_states_pruned_by_bound++;
                 it++;
                 continue;
             }
 
             it->partial_solution = data.partial_solution_factory.add(it->partial_solution, data.s);
             if (!data.l.empty() && it->weight == data.l.back().weight) {
+                number_of_states_pruned_by_dominance++;
                 data.l.back() = *it;
             } else {
                 data.l.push_back(*it);
@@ -263,6 +373,7 @@ void remove_item(DynamicProgrammingPrimalDualInternalData& data)
             // Check state weight.
             Weight weight = it1->weight - item.weight;
             if (weight > maximum_weight) {
+                number_of_states_pruned_by_weight++;
                 it1++;
                 continue;
             }
@@ -270,6 +381,7 @@ void remove_item(DynamicProgrammingPrimalDualInternalData& data)
             Profit profit = it1->profit - item.profit;
             if (!data.l.empty()
                     && profit <= data.l.back().profit) {
+                number_of_states_pruned_by_dominance++;
                 it1++;
                 continue;
             }
@@ -279,6 +391,7 @@ void remove_item(DynamicProgrammingPrimalDualInternalData& data)
                 upper_bound_reverse(instance, profit, weight, sx);
             upper_bound_it = std::max(upper_bound_it, upper_bound_curr);
             if (upper_bound_curr <= data.output.value) {
+                number_of_states_pruned_by_bound++;
                 it1++;
                 continue;
             }
@@ -292,14 +405,16 @@ void remove_item(DynamicProgrammingPrimalDualInternalData& data)
             if (state.weight <= instance.capacity()
                     && state.profit > data.output.value) {
                 if (data.output.number_of_recursive_calls == 1) {
-                    std::stringstream ss;
-                    ss << "it " << data.t - data.s << " (value)";
-                    data.algorithm_formatter.update_value(state.profit, ss.str());
+                    data.algorithm_formatter.update_value(
+                            state.profit,
+                            data.t - data.s,
+                            " (value)");
                 }
                 data.best_state = state;
             }
 
             if (!data.l.empty() && state.weight == data.l.back().weight) {
+                number_of_states_pruned_by_dominance++;
                 data.l.back() = state;
             } else {
                 data.l.push_back(state);
@@ -310,12 +425,21 @@ void remove_item(DynamicProgrammingPrimalDualInternalData& data)
 
     upper_bound_it = std::max(upper_bound_it, data.output.value);
     if (data.output.bound > upper_bound_it) {
-        std::stringstream ss;
-        ss << "it " << data.t - data.s << " (bound)";
-        data.algorithm_formatter.update_bound(upper_bound_it, ss.str());
+        data.algorithm_formatter.update_bound(
+                upper_bound_it,
+                data.t - data.s,
+                " (bound)");
     }
 
     data.l0.swap(data.l);
+
+    if (data.output.statistics.enabled) {
+        update_statistics(
+                data,
+                number_of_states_pruned_by_weight,
+                number_of_states_pruned_by_bound,
+                number_of_states_pruned_by_dominance);
+    }
 }
 
 ItemPos dynamic_programming_primal_dual_find_state(
@@ -367,6 +491,70 @@ ItemPos dynamic_programming_primal_dual_find_state(
     return item_pos_best;
 }
 
+const std::string checkpoint_algorithm = "dynamic-programming-primal-dual";
+
+void write_checkpoint(
+        const DynamicProgrammingPrimalDualInternalData& data,
+        StateId next_pairing)
+{
+    CheckpointWriter writer(
+            data.parameters.checkpoint_path,
+            checkpoint_algorithm,
+            data.instance);
+    writer.write(data.output.solution);
+    writer.write(data.output.value);
+    writer.write(data.output.bound);
+    writer.write(data.parameters.partial_solution_size);
+    data.partial_sort.write_checkpoint(writer);
+    writer.write(data.partial_solution_factory_elements);
+    writer.write(data.s);
+    writer.write(data.t);
+    writer.write(data.remaining_weight);
+    writer.write(data.best_state);
+    writer.write(next_pairing);
+    writer.write(data.l0);
+    writer.commit();
+}
+
+void read_checkpoint(
+        DynamicProgrammingPrimalDualInternalData& data,
+        StateId& next_pairing)
+{
+    CheckpointReader reader(
+            data.parameters.checkpoint_path,
+            checkpoint_algorithm,
+            data.instance);
+    Solution solution(data.instance);
+    reader.read(solution);
+    Profit value = 0;
+    reader.read(value);
+    Profit bound = 0;
+    reader.read(bound);
+    ItemId partial_solution_size = 0;
+    reader.read(partial_solution_size);
+    if (partial_solution_size != data.parameters.partial_solution_size) {
+        throw std::invalid_argument(
+                "The checkpoint has been written with a partial solution size of "
+                + std::to_string(partial_solution_size) + ".");
+    }
+    data.partial_sort.read_checkpoint(reader);
+    reader.read(
+            data.partial_solution_factory_elements,
+            data.instance.number_of_items());
+    for (ItemPos item_pos: data.partial_solution_factory_elements)
+        data.partial_solution_factory.add_element_to_factory(item_pos);
+    reader.read(data.s);
+    reader.read(data.t);
+    reader.read(data.remaining_weight);
+    reader.read(data.best_state);
+    reader.read(next_pairing);
+    reader.read(data.l0);
+
+    data.algorithm_formatter.update_solution(solution, "checkpoint");
+    data.algorithm_formatter.update_value(value, "checkpoint (value)");
+    data.algorithm_formatter.update_bound(bound, "checkpoint (bound)");
+}
+
 }
 
 const DynamicProgrammingPrimalDualOutput knapsacksolver::dynamic_programming_primal_dual(
@@ -414,13 +602,17 @@ const DynamicProgrammingPrimalDualOutput knapsacksolver::dynamic_programming_pri
         return output;
     }
 
+    algorithm_formatter.start_phase("PartialSort");
     DynamicProgrammingPrimalDualInternalData data(instance, parameters, algorithm_formatter, output);
 
     // Get the greedy solution.
+    algorithm_formatter.start_phase("Greedy");
     GreedyParameters greedy_parameters;
     greedy_parameters.timer = parameters.timer;
+    greedy_parameters.stop = parameters.stop;
     greedy_parameters.verbosity_level = 0;
     greedy_parameters.partial_sort = &data.partial_sort;
+    greedy_parameters.extended = true;
     auto greedy_output = greedy(instance, greedy_parameters);
 
     // Update solution.
@@ -429,8 +621,10 @@ const DynamicProgrammingPrimalDualOutput knapsacksolver::dynamic_programming_pri
             "greedy");
 
     // Compute an initial bound.
+    algorithm_formatter.start_phase("DantzigUpperBound");
     UpperBoundDantzigParameters upper_bound_dantzig_parameters;
     upper_bound_dantzig_parameters.timer = parameters.timer;
+    upper_bound_dantzig_parameters.stop = parameters.stop;
     upper_bound_dantzig_parameters.verbosity_level = 0;
     upper_bound_dantzig_parameters.partial_sort = &data.partial_sort;
     auto upper_bound_output = upper_bound_dantzig(
@@ -443,6 +637,7 @@ const DynamicProgrammingPrimalDualOutput knapsacksolver::dynamic_programming_pri
             "dantzig upper bound");
 
     // Recursion.
+    algorithm_formatter.start_phase("DynamicProgramming");
     Weight w_bar = data.partial_sort.break_solution().weight();
     Profit p_bar = data.partial_sort.break_solution().profit();
     data.l0 = {{w_bar, p_bar, 0}};
@@ -451,6 +646,15 @@ const DynamicProgrammingPrimalDualOutput knapsacksolver::dynamic_programming_pri
     data.remaining_weight = w_bar;
     data.best_state = data.l0.front();
     StateId next_pairing = 1e4;
+    if (parameters.resume
+            && !parameters.checkpoint_path.empty()
+            && checkpoint_exists(parameters.checkpoint_path)) {
+        read_checkpoint(data, next_pairing);
+    }
+    double next_checkpoint_time = parameters.timer.elapsed_time()
+        + parameters.checkpoint_interval;
+    DeadlineChecker deadline_checker(parameters, &algorithm_formatter);
+    Counter checkpoint_number_of_checks = deadline_checker.number_of_checks();
     while (!data.l0.empty()
             && (
                 !data.partial_sort.is_intervals_left_empty()
@@ -459,11 +663,25 @@ const DynamicProgrammingPrimalDualOutput knapsacksolver::dynamic_programming_pri
                 || data.t <= data.partial_sort.last_sorted_item_pos())) {
 
         // Check end.
-        if (parameters.timer.needs_to_end()) {
+        if (deadline_checker.needs_to_end(data.l0.size())) {
+            if (!parameters.checkpoint_path.empty())
+                write_checkpoint(data, next_pairing);
             algorithm_formatter.end();
             return output;
         }
 
+        // Write checkpoint. The clock is only read when the deadline checker
+        // reads it.
+        if (!parameters.checkpoint_path.empty()
+                && (parameters.checkpoint_interval <= 0
+                    || (checkpoint_number_of_checks != deadline_checker.number_of_checks()
+                        && parameters.timer.elapsed_time() >= next_checkpoint_time))) {
+            write_checkpoint(data, next_pairing);
+            next_checkpoint_time = parameters.timer.elapsed_time()
+                + parameters.checkpoint_interval;
+        }
+        checkpoint_number_of_checks = deadline_checker.number_of_checks();
+
         if (output.value == output.bound)
             break;
 
@@ -480,7 +698,9 @@ const DynamicProgrammingPrimalDualOutput knapsacksolver::dynamic_programming_pri
                     ++data.t;
 
                     // Check end.
-                    if (parameters.timer.needs_to_end()) {
+                    if (deadline_checker.needs_to_end(data.l0.size())) {
+                        if (!parameters.checkpoint_path.empty())
+                            write_checkpoint(data, next_pairing);
                         algorithm_formatter.end();
                         return output;
                     }
@@ -500,7 +720,9 @@ const DynamicProgrammingPrimalDualOutput knapsacksolver::dynamic_programming_pri
                     --data.s;
 
                     // Check end.
-                    if (parameters.timer.needs_to_end()) {
+                    if (deadline_checker.needs_to_end(data.l0.size())) {
+                        if (!parameters.checkpoint_path.empty())
+                            write_checkpoint(data, next_pairing);
                         algorithm_formatter.end();
                         return output;
                     }
@@ -517,7 +739,9 @@ const DynamicProgrammingPrimalDualOutput knapsacksolver::dynamic_programming_pri
             data.t++;
 
             // Check end.
-            if (parameters.timer.needs_to_end()) {
+            if (deadline_checker.needs_to_end(data.l0.size())) {
+                if (!parameters.checkpoint_path.empty())
+                    write_checkpoint(data, next_pairing);
                 algorithm_formatter.end();
                 return output;
             }
@@ -532,7 +756,9 @@ const DynamicProgrammingPrimalDualOutput knapsacksolver::dynamic_programming_pri
             data.s--;
 
             // Check end.
-            if (parameters.timer.needs_to_end()) {
+            if (deadline_checker.needs_to_end(data.l0.size())) {
+                if (!parameters.checkpoint_path.empty())
+                    write_checkpoint(data, next_pairing);
                 algorithm_formatter.end();
                 return output;
             }
@@ -547,11 +773,19 @@ const DynamicProgrammingPrimalDualOutput knapsacksolver::dynamic_programming_pri
             output.value,
             "algorithm end (bound)");
 
+    algorithm_formatter.start_phase("Reconstruction");
     if (output.solution.profit() == output.bound) {
         algorithm_formatter.end();
         return output;
     }
 
+    // No state is better than the lower bound from the parameters, which is
+    // therefore optimal.
+    if (data.best_state.profit < output.value) {
+        algorithm_formatter.end();
+        return output;
+    }
+
     Solution solution(instance);
     // Add mandatory items from the partial sort.
     for (ItemPos item_pos = 0;
@@ -616,17 +850,23 @@ const DynamicProgrammingPrimalDualOutput knapsacksolver::dynamic_programming_pri
     Instance sub_instance = sub_instance_builder.build();
 
     // Solve sub-instance.
+    algorithm_formatter.start_phase("RecursiveSubSolve");
     DynamicProgrammingPrimalDualParameters sub_parameters;
     sub_parameters.timer = parameters.timer;
+    sub_parameters.stop = parameters.stop;
     sub_parameters.verbosity_level = 0;
+    sub_parameters.memory_limit = parameters.memory_limit;
     auto sub_output = dynamic_programming_primal_dual(sub_instance, sub_parameters);
     // Check end.
-    if (parameters.timer.needs_to_end()) {
+    if (deadline_checker.check()) {
+        if (!parameters.checkpoint_path.empty())
+            write_checkpoint(data, next_pairing);
         algorithm_formatter.end();
         return output;
     }
 
     output.number_of_recursive_calls += sub_output.number_of_recursive_calls;
+    algorithm_formatter.start_phase("Reconstruction");
 
     // Check the number of recursive calls.
     if (instance.number_of_items() <= parameters.partial_solution_size
@@ -653,3 +893,137 @@ const DynamicProgrammingPrimalDualOutput knapsacksolver::dynamic_programming_pri
     algorithm_formatter.end();
     return output;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+///////////////////// DynamicProgrammingPrimalDualSession //////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+void DynamicProgrammingPrimalDualSession::check_item_id(
+        ItemId item_id) const
+{
+    if (item_id < 0 || item_id >= number_of_items()) {
+        throw std::invalid_argument(
+                "Invalid item id: " + std::to_string(item_id) + ".");
+    }
+    if (items_[item_id].removed) {
+        throw std::invalid_argument(
+                "Item " + std::to_string(item_id) + " has been removed.");
+    }
+}
+
+ItemId DynamicProgrammingPrimalDualSession::add_item(
+        Profit profit,
+        Weight weight)
+{
+    SessionItem item;
+    item.profit = profit;
+    item.weight = weight;
+    items_.push_back(item);
+    modified_ = true;
+    return items_.size() - 1;
+}
+
+void DynamicProgrammingPrimalDualSession::remove_item(
+        ItemId item_id)
+{
+    check_item_id(item_id);
+    items_[item_id].removed = true;
+    items_[item_id].contained = false;
+    modified_ = true;
+}
+
+void DynamicProgrammingPrimalDualSession::set_item(
+        ItemId item_id,
+        Profit profit,
+        Weight weight)
+{
+    check_item_id(item_id);
+    items_[item_id].profit = profit;
+    items_[item_id].weight = weight;
+    modified_ = true;
+}
+
+void DynamicProgrammingPrimalDualSession::set_capacity(
+        Weight capacity)
+{
+    capacity_ = capacity;
+    modified_ = true;
+}
+
+const DynamicProgrammingPrimalDualOutput& DynamicProgrammingPrimalDualSession::solve(
+        const DynamicProgrammingPrimalDualParameters& parameters)
+{
+    if (!modified_)
+        return *output_;
+
+    // Build the instance. Items which don't fit in the knapsack are not added.
+    InstanceBuilder instance_builder;
+    instance_builder.set_capacity(capacity_);
+    std::vector<ItemId> instance2session;
+    for (ItemId item_id = 0; item_id < number_of_items(); ++item_id) {
+        const SessionItem& item = items_[item_id];
+        if (item.removed || item.weight > capacity_)
+            continue;
+        instance_builder.add_item(item.profit, item.weight);
+        instance2session.push_back(item_id);
+    }
+    std::unique_ptr<Instance> instance(new Instance(instance_builder.build()));
+
+    // Retrieve the last solution.
+    Solution initial_solution(*instance);
+    for (ItemId item_id = 0;
+            item_id < instance->number_of_items();
+            ++item_id) {
+        if (items_[instance2session[item_id]].contained)
+            initial_solution.add(item_id);
+    }
+
+    // Repair it by removing its least efficient items until it becomes
+    // feasible.
+    if (!initial_solution.feasible()) {
+        std::vector<ItemId> sorted_items;
+        for (ItemId item_id = 0;
+                item_id < instance->number_of_items();
+                ++item_id) {
+            if (initial_solution.contains(item_id))
+                sorted_items.push_back(item_id);
+        }
+        std::sort(
+                sorted_items.begin(),
+                sorted_items.end(),
+                [&instance](ItemId item_id_1, ItemId item_id_2) {
+                    const Item& item_1 = instance->item(item_id_1);
+                    const Item& item_2 = instance->item(item_id_2);
+                    return item_1.profit * item_2.weight < item_2.profit * item_1.weight;
+                });
+        for (ItemId item_id: sorted_items) {
+            if (initial_solution.feasible())
+                break;
+            initial_solution.remove(item_id);
+        }
+    }
+
+    // Solve.
+    DynamicProgrammingPrimalDualParameters solve_parameters = parameters;
+    solve_parameters.initial_solution = &initial_solution;
+    std::unique_ptr<DynamicProgrammingPrimalDualOutput> output(
+            new DynamicProgrammingPrimalDualOutput(
+                dynamic_programming_primal_dual(*instance, solve_parameters)));
+
+    // Save the new solution.
+    for (SessionItem& item: items_)
+        item.contained = false;
+    for (ItemId item_id = 0;
+            item_id < instance->number_of_items();
+            ++item_id) {
+        if (output->solution.contains(item_id))
+            items_[instance2session[item_id]].contained = true;
+    }
+
+    instance_ = std::move(instance);
+    instance2session_ = std::move(instance2session);
+    output_ = std::move(output);
+    // If the solve has been interrupted, solve again at the next call.
+    modified_ = (output_->value != output_->bound);
+    return *output_;
+}
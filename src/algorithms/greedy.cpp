@@ -3,8 +3,69 @@
 #include "knapsacksolver/algorithm_formatter.hpp"
 #include "knapsacksolver/sort.hpp"
 
+#include <memory>
+
 using namespace knapsacksolver;
 
+namespace
+{
+
+/**
+ * Fill a solution with the items which fit, following the order of the sorted
+ * items from position 'item_pos_start'.
+ */
+template <typename Sort>
+void fill(
+        const Sort& sort,
+        ItemPos item_pos_start,
+        Solution& solution)
+{
+    const Instance& instance = solution.instance();
+    for (ItemPos item_pos = item_pos_start;
+            item_pos < instance.number_of_items();
+            ++item_pos) {
+        ItemId item_id = sort.item_id(item_pos);
+        if (solution.contains(item_id))
+            continue;
+        if (solution.weight() + instance.item(item_id).weight
+                <= instance.capacity()) {
+            solution.add(item_id);
+        }
+    }
+}
+
+template <typename Sort>
+void greedy_extended(
+        const Sort& sort,
+        AlgorithmFormatter& algorithm_formatter)
+{
+    const Instance& instance = sort.break_solution().instance();
+    ItemPos break_item_pos = sort.break_item_pos();
+
+    // Fill the break solution with the items after the break item.
+    Solution solution_fill = sort.break_solution();
+    fill(sort, break_item_pos + 1, solution_fill);
+    algorithm_formatter.update_solution(solution_fill, "extended forward");
+
+    // Add the break item to the break solution, remove the least efficient
+    // items until it fits and fill it again.
+    Solution solution_swap = sort.break_solution();
+    solution_swap.add(sort.break_item_id());
+    for (ItemPos item_pos = break_item_pos - 1;
+            item_pos >= 0 && solution_swap.weight() > instance.capacity();
+            --item_pos) {
+        ItemId item_id = sort.item_id(item_pos);
+        if (solution_swap.contains(item_id))
+            solution_swap.remove(item_id);
+    }
+    if (solution_swap.feasible()) {
+        fill(sort, break_item_pos + 1, solution_swap);
+        algorithm_formatter.update_solution(solution_swap, "extended backward");
+    }
+}
+
+}
+
 Output knapsacksolver::greedy(
         const Instance& instance,
         const GreedyParameters& parameters)
@@ -27,24 +88,26 @@ Output knapsacksolver::greedy(
         return output;
     }
 
-    Solution solution_forward(instance);
-    Solution solution_backward(instance);
-
+    // Get the break solution without copying it.
+    std::unique_ptr<PartialSort> partial_sort = nullptr;
+    const Solution* break_solution = nullptr;
+    ItemId break_item_id = -1;
     if (parameters.full_sort != nullptr) {
-        solution_forward = parameters.full_sort->break_solution();
-        solution_backward = parameters.full_sort->break_solution();
-        solution_backward.add(parameters.full_sort->break_item_id());
+        break_solution = &parameters.full_sort->break_solution();
+        break_item_id = parameters.full_sort->break_item_id();
     } else if (parameters.partial_sort != nullptr) {
-        solution_forward = parameters.partial_sort->break_solution();
-        solution_backward = parameters.partial_sort->break_solution();
-        solution_backward.add(parameters.partial_sort->break_item_id());
+        break_solution = &parameters.partial_sort->break_solution();
+        break_item_id = parameters.partial_sort->break_item_id();
     } else {
-        PartialSort partial_sort(instance);
-        solution_forward = partial_sort.break_solution();
-        solution_backward = partial_sort.break_solution();
-        solution_backward.add( partial_sort.break_item_id());
+        partial_sort.reset(new PartialSort(instance));
+        break_solution = &partial_sort->break_solution();
+        break_item_id = partial_sort->break_item_id();
     }
 
+    Solution solution_forward = *break_solution;
+    Solution solution_backward = *break_solution;
+    solution_backward.add(break_item_id);
+
     if (solution_forward.weight() > instance.capacity()) {
         throw std::logic_error("forward");
     }
@@ -74,7 +137,7 @@ Output knapsacksolver::greedy(
         }
         // Backward.
         if (solution_backward.contains(item_id)) {
-            if (solution_forward.weight() - item.weight
+            if (solution_backward.weight() - item.weight
                     <= instance.capacity()) {
                 if (item_id_best_backward == -1
                         || instance.item(item_id_best_backward).profit
@@ -93,6 +156,16 @@ Output knapsacksolver::greedy(
         algorithm_formatter.update_solution(solution_backward, "backward");
     }
 
+    if (parameters.extended) {
+        if (parameters.full_sort != nullptr) {
+            greedy_extended(*parameters.full_sort, algorithm_formatter);
+        } else if (parameters.partial_sort != nullptr) {
+            greedy_extended(*parameters.partial_sort, algorithm_formatter);
+        } else {
+            greedy_extended(*partial_sort, algorithm_formatter);
+        }
+    }
+
     algorithm_formatter.end();
     return output;
 }
@@ -0,0 +1,186 @@
+#include "knapsacksolver/algorithms/portfolio.hpp"
+
+#include "knapsacksolver/algorithm_formatter.hpp"
+#include "knapsacksolver/algorithms/dynamic_programming_bellman.hpp"
+#include "knapsacksolver/algorithms/dynamic_programming_primal_dual.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+using namespace knapsacksolver;
+
+namespace
+{
+
+std::vector<PortfolioAlgorithm> default_algorithms(
+        const Instance& instance,
+        const PortfolioParameters& parameters)
+{
+    std::vector<PortfolioAlgorithm> algorithms;
+    algorithms.push_back({
+            "dynamic-programming-primal-dual",
+            [](const Instance& instance, const Parameters& parameters)
+            {
+                return dynamic_programming_primal_dual(
+                        instance,
+                        portfolio_algorithm_parameters<DynamicProgrammingPrimalDualParameters>(parameters));
+            }});
+    algorithms.push_back({
+            "dynamic-programming-primal-dual-pairing",
+            [](const Instance& instance, const Parameters& parameters)
+            {
+                auto algorithm_parameters = portfolio_algorithm_parameters<DynamicProgrammingPrimalDualParameters>(parameters);
+                algorithm_parameters.pairing = true;
+                return dynamic_programming_primal_dual(
+                        instance,
+                        algorithm_parameters);
+            }});
+    if (instance.capacity() <= parameters.maximum_array_capacity) {
+        algorithms.push_back({
+                "dynamic-programming-bellman-array-part",
+                [](const Instance& instance, const Parameters& parameters)
+                {
+                    return dynamic_programming_bellman_array_part(
+                            instance,
+                            portfolio_algorithm_parameters<DynamicProgrammingBellmanArrayPartParameters>(parameters));
+                }});
+    }
+    return algorithms;
+}
+
+}
+
+const PortfolioOutput knapsacksolver::portfolio(
+        const Instance& instance,
+        const PortfolioParameters& parameters)
+{
+    PortfolioOutput output(instance);
+    AlgorithmFormatter algorithm_formatter(parameters, output);
+    algorithm_formatter.start("Portfolio");
+    algorithm_formatter.print_header();
+
+    std::vector<PortfolioAlgorithm> algorithms = (!parameters.algorithms.empty())?
+        parameters.algorithms:
+        default_algorithms(instance, parameters);
+
+    std::atomic<bool> stop(false);
+    std::atomic<Profit> shared_lower_bound(output.value);
+    std::mutex mutex;
+    std::condition_variable condition_variable;
+    std::size_t number_of_running_algorithms = algorithms.size();
+    std::exception_ptr exception = nullptr;
+    std::size_t number_of_memory_limit_exceeded = 0;
+    std::exception_ptr memory_limit_exceeded = nullptr;
+
+    // Must be called with the mutex locked.
+    auto check_optimality = [&output, &stop](
+            const std::string& algorithm_name)
+    {
+        if (!stop && output.has_solution() && output.value == output.bound) {
+            output.winner = algorithm_name;
+            stop = true;
+        }
+    };
+
+    auto worker = [
+        &instance,
+        &parameters,
+        &algorithms,
+        &output,
+        &algorithm_formatter,
+        &stop,
+        &shared_lower_bound,
+        &mutex,
+        &condition_variable,
+        &number_of_running_algorithms,
+        &exception,
+        &number_of_memory_limit_exceeded,
+        &memory_limit_exceeded,
+        &check_optimality](
+                std::size_t algorithm_pos)
+    {
+        const PortfolioAlgorithm& algorithm = algorithms[algorithm_pos];
+        Parameters algorithm_parameters;
+        algorithm_parameters.timer = parameters.timer;
+        algorithm_parameters.verbosity_level = 0;
+        algorithm_parameters.stop = &stop;
+        algorithm_parameters.shared_lower_bound = &shared_lower_bound;
+        // The algorithms run at the same time and share the memory limit.
+        if (parameters.memory_limit >= 0)
+            algorithm_parameters.memory_limit = parameters.memory_limit / algorithms.size();
+        algorithm_parameters.new_solution_callback = [
+            &algorithm,
+            &algorithm_formatter,
+            &mutex,
+            &check_optimality](
+                    const Output& algorithm_output)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            algorithm_formatter.update_solution(
+                    algorithm_output.solution,
+                    algorithm.name);
+            check_optimality(algorithm.name);
+        };
+
+        try {
+            Output algorithm_output = algorithm.algorithm(
+                    instance,
+                    algorithm_parameters);
+            std::lock_guard<std::mutex> lock(mutex);
+            algorithm_formatter.update_solution(
+                    algorithm_output.solution,
+                    algorithm.name + " (solution)");
+            algorithm_formatter.update_bound(
+                    algorithm_output.bound,
+                    algorithm.name + " (bound)");
+            check_optimality(algorithm.name);
+        } catch (const MemoryLimitExceeded&) {
+            // Let the other algorithms run; the exception is only rethrown if
+            // all of them exceed the memory limit.
+            std::lock_guard<std::mutex> lock(mutex);
+            number_of_memory_limit_exceeded++;
+            if (memory_limit_exceeded == nullptr)
+                memory_limit_exceeded = std::current_exception();
+        } catch (...) {
+            // Stop all the algorithms and rethrow the exception once they are
+            // joined.
+            std::lock_guard<std::mutex> lock(mutex);
+            if (exception == nullptr)
+                exception = std::current_exception();
+            stop = true;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        number_of_running_algorithms--;
+        condition_variable.notify_one();
+    };
+
+    std::vector<std::thread> threads;
+    for (std::size_t algorithm_pos = 0;
+            algorithm_pos < algorithms.size();
+            ++algorithm_pos) {
+        threads.push_back(std::thread(worker, algorithm_pos));
+    }
+
+    // Wait for the algorithms, forwarding the external stop flag.
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (number_of_running_algorithms > 0) {
+            condition_variable.wait_for(lock, std::chrono::milliseconds(10));
+            if (parameters.stop != nullptr && parameters.stop->load())
+                stop = true;
+        }
+    }
+    for (std::thread& thread: threads)
+        thread.join();
+    if (exception != nullptr)
+        std::rethrow_exception(exception);
+    if (memory_limit_exceeded != nullptr
+            && number_of_memory_limit_exceeded == algorithms.size())
+        std::rethrow_exception(memory_limit_exceeded);
+
+    algorithm_formatter.end();
+    return output;
+}
@@ -0,0 +1,335 @@
+#include "knapsacksolver/batch.hpp"
+
+#include "knapsacksolver/instance_builder.hpp"
+#include "knapsacksolver/algorithms/dynamic_programming_primal_dual.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+using namespace knapsacksolver;
+
+Instance knapsacksolver::read_batch_manifest_line(
+        const std::string& line,
+        Counter line_number,
+        const std::string& format,
+        std::string& name)
+{
+    InstanceBuilder instance_builder;
+    if (line[0] != '{') {
+        name = line;
+        instance_builder.read(line, format);
+        return instance_builder.build();
+    }
+
+    // Inline instance.
+    name = "line " + std::to_string(line_number);
+    try {
+        nlohmann::json json = nlohmann::json::parse(line);
+        if (json.count("Name"))
+            name = json["Name"].get<std::string>();
+        const nlohmann::json& profits = json.at("Profits");
+        const nlohmann::json& weights = json.at("Weights");
+        if (profits.size() != weights.size()) {
+            throw std::invalid_argument(
+                    "The numbers of profits and weights differ.");
+        }
+        instance_builder.set_capacity(json.at("Capacity").get<Weight>());
+        for (std::size_t item_id = 0; item_id < profits.size(); ++item_id) {
+            instance_builder.add_item(
+                    profits[item_id].get<Profit>(),
+                    weights[item_id].get<Weight>());
+        }
+    } catch (const nlohmann::json::exception& e) {
+        throw std::invalid_argument(
+                "Invalid inline instance at line "
+                + std::to_string(line_number) + ": " + e.what());
+    }
+    return instance_builder.build();
+}
+
+std::vector<Instance> knapsacksolver::read_batch_manifest(
+        std::istream& manifest,
+        const std::string& format,
+        std::vector<std::string>& names)
+{
+    std::vector<Instance> instances;
+    std::string line;
+    Counter line_number = 0;
+    while (std::getline(manifest, line)) {
+        line_number++;
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+        if (line.empty())
+            continue;
+        std::string name;
+        instances.push_back(read_batch_manifest_line(
+                    line,
+                    line_number,
+                    format,
+                    name));
+        names.push_back(name);
+    }
+    return instances;
+}
+
+namespace
+{
+
+std::size_t batch_number_of_threads(
+        const BatchParameters& parameters)
+{
+    std::size_t number_of_threads = parameters.number_of_threads;
+    if (number_of_threads == 0)
+        number_of_threads = (std::max)(1u, std::thread::hardware_concurrency());
+    return number_of_threads;
+}
+
+Output solve_batch_instance(
+        const Instance& instance,
+        const BatchParameters& parameters,
+        DynamicProgrammingPrimalDualWorkspace& workspace)
+{
+    // The timer of the parameters starts now.
+    DynamicProgrammingPrimalDualParameters instance_parameters;
+    instance_parameters.verbosity_level = 0;
+    if (parameters.time_limit >= 0)
+        instance_parameters.timer.set_time_limit(parameters.time_limit);
+    instance_parameters.memory_limit = parameters.memory_limit;
+    if (parameters.algorithm)
+        return parameters.algorithm(instance, instance_parameters);
+    instance_parameters.workspace = &workspace;
+    return dynamic_programming_primal_dual(instance, instance_parameters);
+}
+
+double elapsed_time(
+        std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count();
+}
+
+}
+
+BatchOutput knapsacksolver::solve_batch(
+        const std::vector<Instance>& instances,
+        const BatchParameters& parameters)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    BatchOutput output;
+    output.number_of_instances = instances.size();
+    output.outputs.reserve(instances.size());
+    for (const Instance& instance: instances)
+        output.outputs.emplace_back(instance);
+
+    std::atomic<std::size_t> next_instance_pos(0);
+    std::atomic<Counter> number_of_errors(0);
+    std::mutex exception_mutex;
+    std::exception_ptr exception = nullptr;
+    auto worker = [
+        &instances,
+        &parameters,
+        &output,
+        &next_instance_pos,
+        &number_of_errors,
+        &exception_mutex,
+        &exception]()
+    {
+        // Each thread reuses its own lists of states.
+        DynamicProgrammingPrimalDualWorkspace workspace;
+        for (;;) {
+            std::size_t instance_pos = next_instance_pos++;
+            if (instance_pos >= instances.size())
+                break;
+            BatchEntry entry;
+            entry.position = instance_pos;
+            try {
+                output.outputs[instance_pos] = solve_batch_instance(
+                        instances[instance_pos],
+                        parameters,
+                        workspace);
+                if (parameters.new_output_callback)
+                    parameters.new_output_callback(entry, output.outputs[instance_pos]);
+            } catch (const std::exception& e) {
+                number_of_errors++;
+                if (parameters.error_callback) {
+                    parameters.error_callback(entry, e);
+                    continue;
+                }
+                // Stop all the threads and rethrow the exception once they
+                // are joined.
+                std::lock_guard<std::mutex> lock(exception_mutex);
+                if (exception == nullptr)
+                    exception = std::current_exception();
+                next_instance_pos = instances.size();
+                break;
+            }
+        }
+    };
+
+    std::size_t number_of_threads = (std::min)(
+            batch_number_of_threads(parameters),
+            instances.size());
+    std::vector<std::thread> threads;
+    for (std::size_t thread_id = 1; thread_id < number_of_threads; ++thread_id)
+        threads.push_back(std::thread(worker));
+    worker();
+    for (std::thread& thread: threads)
+        thread.join();
+    if (exception != nullptr)
+        std::rethrow_exception(exception);
+
+    output.number_of_errors = number_of_errors;
+    output.time = elapsed_time(start);
+    if (output.time > 0)
+        output.throughput = instances.size() / output.time;
+    return output;
+}
+
+BatchOutput knapsacksolver::solve_batch_manifest(
+        std::istream& manifest,
+        const std::string& format,
+        const BatchParameters& parameters)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    std::size_t number_of_threads = batch_number_of_threads(parameters);
+    std::size_t look_ahead = (parameters.look_ahead > 0)?
+        parameters.look_ahead:
+        4 * number_of_threads;
+
+    // Instances read but not yet taken by a thread.
+    std::deque<std::pair<BatchEntry, std::unique_ptr<Instance>>> queue;
+    bool end_of_manifest = false;
+    std::mutex queue_mutex;
+    // Notified when an instance is added to the queue or the reading ends.
+    std::condition_variable queue_not_empty;
+    // Notified when an instance is taken from the queue or a thread stops.
+    std::condition_variable queue_not_full;
+    std::atomic<Counter> number_of_errors(0);
+    std::exception_ptr exception = nullptr;
+
+    auto worker = [
+        &parameters,
+        &queue,
+        &end_of_manifest,
+        &queue_mutex,
+        &queue_not_empty,
+        &queue_not_full,
+        &number_of_errors,
+        &exception]()
+    {
+        // Each thread reuses its own lists of states.
+        DynamicProgrammingPrimalDualWorkspace workspace;
+        for (;;) {
+            std::pair<BatchEntry, std::unique_ptr<Instance>> task;
+            {
+                std::unique_lock<std::mutex> lock(queue_mutex);
+                queue_not_empty.wait(lock, [&queue, &end_of_manifest]()
+                        {
+                            return !queue.empty() || end_of_manifest;
+                        });
+                if (queue.empty())
+                    break;
+                task = std::move(queue.front());
+                queue.pop_front();
+            }
+            queue_not_full.notify_one();
+            try {
+                Output output = solve_batch_instance(
+                        *task.second,
+                        parameters,
+                        workspace);
+                if (parameters.new_output_callback)
+                    parameters.new_output_callback(task.first, output);
+            } catch (const std::exception& e) {
+                number_of_errors++;
+                if (parameters.error_callback) {
+                    parameters.error_callback(task.first, e);
+                    continue;
+                }
+                // Stop reading the manifest and rethrow the exception once
+                // the threads are joined.
+                std::lock_guard<std::mutex> lock(queue_mutex);
+                if (exception == nullptr)
+                    exception = std::current_exception();
+                end_of_manifest = true;
+                queue.clear();
+                queue_not_empty.notify_all();
+                queue_not_full.notify_all();
+                break;
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (std::size_t thread_id = 0; thread_id < number_of_threads; ++thread_id)
+        threads.push_back(std::thread(worker));
+
+    BatchOutput output;
+    std::string line;
+    Counter line_number = 0;
+    std::size_t instance_pos = 0;
+    while (std::getline(manifest, line)) {
+        line_number++;
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+        if (line.empty())
+            continue;
+        BatchEntry entry;
+        entry.position = instance_pos++;
+        entry.line_number = line_number;
+        std::unique_ptr<Instance> instance;
+        try {
+            instance.reset(new Instance(read_batch_manifest_line(
+                            line,
+                            line_number,
+                            format,
+                            entry.name)));
+        } catch (const std::exception& e) {
+            number_of_errors++;
+            if (parameters.error_callback) {
+                parameters.error_callback(entry, e);
+                continue;
+            }
+            std::lock_guard<std::mutex> lock(queue_mutex);
+            if (exception == nullptr)
+                exception = std::current_exception();
+            queue.clear();
+            break;
+        }
+
+        std::unique_lock<std::mutex> lock(queue_mutex);
+        queue_not_full.wait(lock, [&queue, &end_of_manifest, look_ahead]()
+                {
+                    return queue.size() < look_ahead || end_of_manifest;
+                });
+        // A thread failed.
+        if (end_of_manifest)
+            break;
+        queue.emplace_back(std::move(entry), std::move(instance));
+        lock.unlock();
+        queue_not_empty.notify_one();
+    }
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        end_of_manifest = true;
+    }
+    queue_not_empty.notify_all();
+    for (std::thread& thread: threads)
+        thread.join();
+    if (exception != nullptr)
+        std::rethrow_exception(exception);
+
+    output.number_of_instances = instance_pos;
+    output.number_of_errors = number_of_errors;
+    output.time = elapsed_time(start);
+    if (output.time > 0)
+        output.throughput = instance_pos / output.time;
+    return output;
+}
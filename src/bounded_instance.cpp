@@ -0,0 +1,83 @@
+#include "knapsacksolver/bounded_instance.hpp"
+
+#include <iomanip>
+#include <limits>
+#include <stdexcept>
+
+using namespace knapsacksolver;
+
+void BoundedInstance::format(
+        std::ostream& os,
+        int verbosity_level) const
+{
+    if (verbosity_level >= 1) {
+        os
+            << "Number of items:         " << number_of_items() << std::endl
+            << "Total number of copies:  " << total_number_of_copies() << std::endl
+            << "Capacity:                " << capacity() << std::endl
+            ;
+    }
+
+    if (verbosity_level >= 2) {
+        os
+            << std::endl
+            << std::setw(12) << "Item"
+            << std::setw(12) << "Weight"
+            << std::setw(24) << "Profit"
+            << std::setw(12) << "Copies"
+            << std::endl
+            << std::setw(12) << "----"
+            << std::setw(12) << "------"
+            << std::setw(24) << "------"
+            << std::setw(12) << "------"
+            << std::endl;
+        for (ItemId item_id = 0; item_id < number_of_items(); ++item_id) {
+            const BoundedItem& item = this->item(item_id);
+            os
+                << std::setw(12) << item_id
+                << std::setw(12) << item.weight
+                << std::setw(24) << item.profit
+                << std::setw(12) << item.number_of_copies
+                << std::endl;
+        }
+    }
+}
+
+void BoundedInstanceBuilder::add_item(
+        Profit profit,
+        Weight weight,
+        ItemId number_of_copies)
+{
+    if (weight < 0) {
+        throw std::invalid_argument(
+                "Item weights must be non-negative.");
+    }
+    if (number_of_copies < 0) {
+        throw std::invalid_argument(
+                "Item numbers of copies must be non-negative.");
+    }
+
+    BoundedItem item;
+    item.profit = profit;
+    item.weight = weight;
+    item.number_of_copies = number_of_copies;
+    instance_.items_.push_back(item);
+}
+
+BoundedInstance BoundedInstanceBuilder::build()
+{
+    // Compute total number of copies.
+    for (ItemId item_id = 0;
+            item_id < instance_.number_of_items();
+            ++item_id) {
+        const BoundedItem& item = instance_.items_[item_id];
+        if (item.number_of_copies > std::numeric_limits<ItemId>::max()
+                - instance_.total_number_of_copies_) {
+            throw std::overflow_error(
+                    "Overflow while computing the total number of copies.");
+        }
+        instance_.total_number_of_copies_ += item.number_of_copies;
+    }
+
+    return std::move(instance_);
+}
@@ -0,0 +1,175 @@
+#include "knapsacksolver/checkpoint.hpp"
+
+#include <cstdio>
+
+using namespace knapsacksolver;
+
+namespace
+{
+
+/** Attributes of an instance stored in the header of a checkpoint. */
+struct CheckpointInstance
+{
+    int64_t number_of_items;
+    int64_t capacity;
+    int64_t total_item_profit;
+    int64_t total_item_weight;
+    /** FNV-1a hash of the capacity and of the profits and weights. */
+    uint64_t hash;
+};
+
+void hash_value(uint64_t& hash, int64_t value)
+{
+    for (int byte = 0; byte < 8; ++byte) {
+        hash ^= (uint64_t)(value >> (8 * byte)) & 0xff;
+        hash *= 1099511628211ull;
+    }
+}
+
+CheckpointInstance checkpoint_instance(const Instance& instance)
+{
+    CheckpointInstance checkpoint_instance;
+    checkpoint_instance.number_of_items = instance.number_of_items();
+    checkpoint_instance.capacity = instance.capacity();
+    checkpoint_instance.total_item_profit = instance.total_item_profit();
+    checkpoint_instance.total_item_weight = instance.total_item_weight();
+    checkpoint_instance.hash = 14695981039346656037ull;
+    hash_value(checkpoint_instance.hash, instance.capacity());
+    for (ItemId item_id = 0;
+            item_id < instance.number_of_items();
+            ++item_id) {
+        const Item& item = instance.item(item_id);
+        hash_value(checkpoint_instance.hash, item.profit);
+        hash_value(checkpoint_instance.hash, item.weight);
+    }
+    return checkpoint_instance;
+}
+
+}
+
+CheckpointWriter::CheckpointWriter(
+        const std::string& checkpoint_path,
+        const std::string& algorithm,
+        const Instance& instance):
+    checkpoint_path_(checkpoint_path),
+    temporary_path_(checkpoint_path + ".tmp"),
+    file_(temporary_path_, std::ios::binary)
+{
+    if (!file_.good()) {
+        throw std::runtime_error(
+                "Unable to open file \"" + temporary_path_ + "\".");
+    }
+    file_.write(checkpoint_magic, sizeof(checkpoint_magic));
+    write(checkpoint_version);
+    std::vector<char> algorithm_name(algorithm.begin(), algorithm.end());
+    write(algorithm_name);
+    write(checkpoint_instance(instance));
+}
+
+void CheckpointWriter::write(const Solution& solution)
+{
+    std::vector<ItemId> item_ids;
+    item_ids.reserve(solution.number_of_items());
+    for (ItemId item_id = 0;
+            item_id < solution.instance().number_of_items();
+            ++item_id) {
+        if (solution.contains(item_id))
+            item_ids.push_back(item_id);
+    }
+    write(item_ids);
+}
+
+void CheckpointWriter::commit()
+{
+    file_.close();
+    if (file_.fail()) {
+        throw std::runtime_error(
+                "Unable to write file \"" + temporary_path_ + "\".");
+    }
+#ifdef _WIN32
+    // 'rename' doesn't replace an existing file on Windows.
+    std::remove(checkpoint_path_.c_str());
+#endif
+    if (std::rename(temporary_path_.c_str(), checkpoint_path_.c_str()) != 0) {
+        throw std::runtime_error(
+                "Unable to rename file \"" + temporary_path_ + "\" to \""
+                + checkpoint_path_ + "\".");
+    }
+}
+
+CheckpointReader::CheckpointReader(
+        const std::string& checkpoint_path,
+        const std::string& algorithm,
+        const Instance& instance):
+    checkpoint_path_(checkpoint_path),
+    file_(checkpoint_path, std::ios::binary)
+{
+    if (!file_.good()) {
+        throw std::runtime_error(
+                "Unable to open file \"" + checkpoint_path + "\".");
+    }
+    file_.seekg(0, std::ios::end);
+    file_size_ = file_.tellg();
+    file_.seekg(0, std::ios::beg);
+    char magic[sizeof(checkpoint_magic)];
+    file_.read(magic, sizeof(magic));
+    check();
+    if (!std::equal(magic, magic + sizeof(magic), checkpoint_magic)) {
+        throw std::invalid_argument(
+                "File \"" + checkpoint_path + "\" is not a checkpoint file.");
+    }
+    uint32_t version = 0;
+    read(version);
+    if (version != checkpoint_version) {
+        throw std::invalid_argument(
+                "Unsupported checkpoint version "
+                + std::to_string(version) + ".");
+    }
+    std::vector<char> algorithm_name;
+    read(algorithm_name, 256);
+    if (std::string(algorithm_name.begin(), algorithm_name.end()) != algorithm) {
+        throw std::invalid_argument(
+                "The checkpoint \"" + checkpoint_path
+                + "\" hasn't been written by algorithm \"" + algorithm + "\".");
+    }
+    CheckpointInstance checkpoint_instance_read;
+    read(checkpoint_instance_read);
+    CheckpointInstance checkpoint_instance_expected = checkpoint_instance(instance);
+    if (checkpoint_instance_read.number_of_items != checkpoint_instance_expected.number_of_items
+            || checkpoint_instance_read.capacity != checkpoint_instance_expected.capacity
+            || checkpoint_instance_read.total_item_profit != checkpoint_instance_expected.total_item_profit
+            || checkpoint_instance_read.total_item_weight != checkpoint_instance_expected.total_item_weight
+            || checkpoint_instance_read.hash != checkpoint_instance_expected.hash) {
+        throw std::invalid_argument(
+                "The checkpoint \"" + checkpoint_path
+                + "\" has been written for another instance.");
+    }
+}
+
+void CheckpointReader::read(Solution& solution)
+{
+    std::vector<ItemId> item_ids;
+    read(item_ids, solution.instance().number_of_items());
+    for (ItemId item_id: item_ids) {
+        if (item_id < 0 || item_id >= solution.instance().number_of_items()) {
+            throw std::invalid_argument(
+                    "The checkpoint \"" + checkpoint_path_ + "\" is corrupted.");
+        }
+        solution.add(item_id);
+    }
+}
+
+void CheckpointReader::check()
+{
+    if (!file_.good()) {
+        throw std::invalid_argument(
+                "The checkpoint \"" + checkpoint_path_ + "\" is truncated.");
+    }
+}
+
+bool knapsacksolver::checkpoint_exists(
+        const std::string& checkpoint_path)
+{
+    std::ifstream file(checkpoint_path);
+    return file.good();
+}
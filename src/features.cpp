@@ -0,0 +1,179 @@
+#include "knapsacksolver/features.hpp"
+
+#include "knapsacksolver/sort.hpp"
+
+#include <cmath>
+#include <iomanip>
+
+using namespace knapsacksolver;
+
+namespace
+{
+
+Weight gcd(Weight a, Weight b)
+{
+    while (b != 0) {
+        Weight r = a % b;
+        a = b;
+        b = r;
+    }
+    return a;
+}
+
+}
+
+nlohmann::json InstanceFeatures::to_json() const
+{
+    return nlohmann::json {
+        {"NumberOfItems", number_of_items},
+        {"Capacity", capacity},
+        {"CapacityRatio", capacity_ratio},
+        {"MinimumWeight", minimum_weight},
+        {"MaximumWeight", maximum_weight},
+        {"MinimumProfit", minimum_profit},
+        {"MaximumProfit", maximum_profit},
+        {"WeightProfitCorrelation", weight_profit_correlation},
+        {"SubsetSum", subset_sum},
+        {"WeightGcd", weight_gcd},
+        {"EstimatedCoreSize", estimated_core_size}};
+}
+
+void InstanceFeatures::format(std::ostream& os) const
+{
+    int width = 31;
+    os
+        << std::setw(width) << std::left << "Number of items: " << number_of_items << std::endl
+        << std::setw(width) << std::left << "Capacity: " << capacity << std::endl
+        << std::setw(width) << std::left << "Capacity ratio: " << capacity_ratio << std::endl
+        << std::setw(width) << std::left << "Weights: " << minimum_weight << " - " << maximum_weight << std::endl
+        << std::setw(width) << std::left << "Profits: " << minimum_profit << " - " << maximum_profit << std::endl
+        << std::setw(width) << std::left << "Weight/profit correlation: " << weight_profit_correlation << std::endl
+        << std::setw(width) << std::left << "Subset sum: " << subset_sum << std::endl
+        << std::setw(width) << std::left << "Weight GCD: " << weight_gcd << std::endl
+        << std::setw(width) << std::left << "Estimated core size: " << estimated_core_size << std::endl
+        ;
+}
+
+InstanceFeatures knapsacksolver::compute_features(
+        const Instance& instance)
+{
+    InstanceFeatures features;
+    features.number_of_items = instance.number_of_items();
+    features.capacity = instance.capacity();
+    if (instance.total_item_weight() > 0) {
+        features.capacity_ratio = (double)instance.capacity()
+            / instance.total_item_weight();
+    }
+    if (instance.number_of_items() == 0)
+        return features;
+
+    features.minimum_weight = instance.item(0).weight;
+    features.minimum_profit = instance.item(0).profit;
+    features.subset_sum = true;
+    features.weight_gcd = instance.capacity();
+    double n = instance.number_of_items();
+    double mean_weight = (double)instance.total_item_weight() / n;
+    double mean_profit = (double)instance.total_item_profit() / n;
+    double covariance = 0;
+    double weight_variance = 0;
+    double profit_variance = 0;
+    for (ItemId item_id = 0;
+            item_id < instance.number_of_items();
+            ++item_id) {
+        const Item& item = instance.item(item_id);
+        features.minimum_weight = (std::min)(features.minimum_weight, item.weight);
+        features.maximum_weight = (std::max)(features.maximum_weight, item.weight);
+        features.minimum_profit = (std::min)(features.minimum_profit, item.profit);
+        features.maximum_profit = (std::max)(features.maximum_profit, item.profit);
+        if (item.profit != item.weight)
+            features.subset_sum = false;
+        if (features.weight_gcd != 1)
+            features.weight_gcd = gcd(features.weight_gcd, item.weight);
+        double dw = item.weight - mean_weight;
+        double dp = item.profit - mean_profit;
+        covariance += dw * dp;
+        weight_variance += dw * dw;
+        profit_variance += dp * dp;
+    }
+    if (weight_variance > 0 && profit_variance > 0) {
+        features.weight_profit_correlation = covariance
+            / std::sqrt(weight_variance * profit_variance);
+    } else {
+        // All the weights or all the profits are equal.
+        features.weight_profit_correlation = 1.0;
+    }
+
+    // Estimate the size of the core from the efficiency of the break item.
+    if (instance.total_item_weight() <= instance.capacity()) {
+        features.estimated_core_size = 0;
+    } else if (std::numeric_limits<Profit>::max() / instance.highest_item_weight()
+            <= instance.highest_item_profit()) {
+        features.estimated_core_size = -1;
+    } else {
+        PartialSort partial_sort(instance);
+        double break_efficiency = instance.item(
+                partial_sort.break_item_id()).efficiency;
+        for (ItemId item_id = 0;
+                item_id < instance.number_of_items();
+                ++item_id) {
+            double efficiency = instance.item(item_id).efficiency;
+            if (std::abs(efficiency - break_efficiency) < 0.01 * break_efficiency)
+                features.estimated_core_size++;
+        }
+    }
+
+    return features;
+}
+
+nlohmann::json AlgorithmSelection::to_json() const
+{
+    return nlohmann::json {
+        {"Algorithm", algorithm},
+        {"Pairing", pairing},
+        {"Reason", reason},
+        {"Features", features.to_json()}};
+}
+
+void AlgorithmSelection::format(std::ostream& os) const
+{
+    int width = 31;
+    features.format(os);
+    os
+        << std::setw(width) << std::left << "Selected algorithm: " << algorithm << std::endl
+        << std::setw(width) << std::left << "Pairing: " << pairing << std::endl
+        << std::setw(width) << std::left << "Reason: " << reason << std::endl
+        ;
+}
+
+AlgorithmSelection knapsacksolver::select_algorithm(
+        const InstanceFeatures& features)
+{
+    AlgorithmSelection selection;
+    selection.features = features;
+    ItemId n = features.number_of_items;
+    bool large_coefficients = (features.maximum_weight
+            >= 100 * (Weight)n);
+    bool large_core = (features.estimated_core_size == -1
+            || 2 * features.estimated_core_size >= n);
+    if (n == 0 || features.capacity_ratio >= 1) {
+        selection.algorithm = "greedy";
+        selection.reason = "all the items fit";
+    } else if (large_core
+            && features.weight_gcd == 1
+            && (double)n * (features.capacity + 1) <= 1e6) {
+        selection.algorithm = "dynamic-programming-bellman-array-rec";
+        selection.reason = "large core and small capacity";
+    } else if (features.subset_sum && large_coefficients) {
+        selection.algorithm = "dynamic-programming-primal-dual";
+        selection.pairing = true;
+        selection.reason = "subset sum instance with large coefficients";
+    } else if (large_core && large_coefficients) {
+        selection.algorithm = "dynamic-programming-primal-dual";
+        selection.pairing = true;
+        selection.reason = "large core with large coefficients";
+    } else {
+        selection.algorithm = "dynamic-programming-primal-dual";
+        selection.reason = "default";
+    }
+    return selection;
+}
@@ -2,28 +2,38 @@
 
 #include "knapsacksolver/instance_builder.hpp"
 
+#include <atomic>
 #include <cmath>
+#include <functional>
+#include <mutex>
+#include <thread>
 
 using namespace knapsacksolver;
 
-Instance knapsacksolver::generate_u(
+namespace
+{
+
+/**
+ * Generate an instance whose weights are drawn uniformly in
+ * [1, maximum_weight] and whose profits are computed from the weights.
+ */
+Instance generate_from_weights(
         ItemPos number_of_items,
         Weight maximum_weight,
-        Profit maximum_profit,
         double capacity_ratio,
-        std::mt19937_64& generator)
+        std::mt19937_64& generator,
+        const std::function<Profit(Weight)>& profit)
 {
     InstanceBuilder instance_builder;
+    instance_builder.reserve(number_of_items);
 
     // Add items.
+    std::uniform_int_distribution<Weight> distribution_weight(1, maximum_weight);
     Weight weight_max = 0;
     Weight weight_sum = 0;
     for (ItemPos pos = 0; pos < number_of_items; ++pos) {
-        std::uniform_int_distribution<Weight> distribution_weight(1, maximum_weight);
-        std::uniform_int_distribution<Profit> distribution_profit(1, maximum_profit);
         Weight weight = distribution_weight(generator);
-        Profit profit = distribution_profit(generator);
-        instance_builder.add_item(profit, weight);
+        instance_builder.add_item(profit(weight), weight);
 
         weight_max = std::max(weight_max, weight);
         weight_sum += weight;
@@ -37,3 +47,305 @@ Instance knapsacksolver::generate_u(
 
     return instance_builder.build();
 }
+
+}
+
+Instance knapsacksolver::generate_u(
+        ItemPos number_of_items,
+        Weight maximum_weight,
+        Profit maximum_profit,
+        double capacity_ratio,
+        std::mt19937_64& generator)
+{
+    std::uniform_int_distribution<Profit> distribution_profit(1, maximum_profit);
+    return generate_from_weights(
+            number_of_items,
+            maximum_weight,
+            capacity_ratio,
+            generator,
+            [&distribution_profit, &generator](Weight)
+            {
+                return distribution_profit(generator);
+            });
+}
+
+Instance knapsacksolver::generate_wc(
+        ItemPos number_of_items,
+        Weight maximum_weight,
+        double capacity_ratio,
+        std::mt19937_64& generator)
+{
+    Profit delta = maximum_weight / 10;
+    return generate_from_weights(
+            number_of_items,
+            maximum_weight,
+            capacity_ratio,
+            generator,
+            [delta, &generator](Weight weight)
+            {
+                std::uniform_int_distribution<Profit> distribution_profit(
+                        std::max((Profit)1, weight - delta),
+                        weight + delta);
+                return distribution_profit(generator);
+            });
+}
+
+Instance knapsacksolver::generate_sc(
+        ItemPos number_of_items,
+        Weight maximum_weight,
+        double capacity_ratio,
+        std::mt19937_64& generator)
+{
+    Profit delta = maximum_weight / 10;
+    return generate_from_weights(
+            number_of_items,
+            maximum_weight,
+            capacity_ratio,
+            generator,
+            [delta](Weight weight) { return weight + delta; });
+}
+
+Instance knapsacksolver::generate_ss(
+        ItemPos number_of_items,
+        Weight maximum_weight,
+        double capacity_ratio,
+        std::mt19937_64& generator)
+{
+    return generate_from_weights(
+            number_of_items,
+            maximum_weight,
+            capacity_ratio,
+            generator,
+            [](Weight weight) { return weight; });
+}
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////// Generator ///////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+
+/** Draw an item according to the type of the instance. */
+Item generate_item(
+        const Generator& generator,
+        std::mt19937_64& random_generator)
+{
+    const Profit& r = generator.r;
+
+    // Draw the weight.
+    Weight weight = 0;
+    if (generator.normal) {
+        std::normal_distribution<double> distribution_weight(
+                (double)r / 2,
+                (double)r / generator.dw);
+        weight = std::llround(distribution_weight(random_generator));
+        weight = std::max((Weight)1, std::min(r, weight));
+    } else {
+        std::uniform_int_distribution<Weight> distribution_weight(1, r);
+        weight = distribution_weight(random_generator);
+    }
+
+    // Compute the profit.
+    Item item;
+    item.weight = weight;
+    if (generator.t == "u") {
+        std::uniform_int_distribution<Profit> distribution_profit(1, r);
+        item.profit = distribution_profit(random_generator);
+    } else if (generator.t == "wc") {
+        std::uniform_int_distribution<Profit> distribution_profit(
+                std::max((Profit)1, weight - r / 10),
+                weight + r / 10);
+        item.profit = distribution_profit(random_generator);
+    } else if (generator.t == "sc") {
+        item.profit = weight + r / 10;
+    } else if (generator.t == "isc") {
+        item.profit = weight;
+        item.weight = weight + r / 10;
+    } else if (generator.t == "asc") {
+        std::uniform_int_distribution<Profit> distribution_profit(
+                weight + r / 10 - r / 500,
+                weight + r / 10 + r / 500);
+        item.profit = distribution_profit(random_generator);
+    } else if (generator.t == "ss") {
+        item.profit = weight;
+    } else if (generator.t == "sw") {
+        std::uniform_int_distribution<Weight> distribution_weight(100000, 100100);
+        std::uniform_int_distribution<Profit> distribution_profit(1, 1000);
+        item.weight = distribution_weight(random_generator);
+        item.profit = distribution_profit(random_generator);
+    } else if (generator.t == "mstr") {
+        Profit k1 = (generator.k1 >= 0)? generator.k1: 3 * r / 10;
+        Profit k2 = (generator.k2 >= 0)? generator.k2: 2 * r / 10;
+        Weight d = (generator.d > 0)? (Weight)generator.d: 6;
+        item.profit = (weight % d == 0)? weight + k1: weight + k2;
+    } else if (generator.t == "pceil") {
+        Weight d = (generator.d > 0)? (Weight)generator.d: 3;
+        item.profit = d * ((weight + d - 1) / d);
+    } else if (generator.t == "circle") {
+        double d = (generator.d > 0)? generator.d: 2.0 / 3;
+        double radius_2 = 4.0 * r * r;
+        double delta = (double)(weight - 2 * r);
+        item.profit = (Profit)(d * std::sqrt(radius_2 - delta * delta));
+    } else {
+        throw std::invalid_argument(
+                "Unknown instance type \"" + generator.t + "\".");
+    }
+    item.profit = std::max((Profit)1, item.profit);
+    return item;
+}
+
+}
+
+Instance Generator::generate() const
+{
+    if (n < 0) {
+        throw std::invalid_argument(
+                "The number of items must be positive.");
+    }
+    if (r < 1) {
+        throw std::invalid_argument(
+                "'r' must be greater than or equal to 1.");
+    }
+
+    std::mt19937_64 random_generator(s);
+    InstanceBuilder instance_builder;
+    instance_builder.reserve(n);
+
+    // Draw the spanner items.
+    std::vector<Item> spanner_items;
+    if (spanner) {
+        if (v < 1 || m < 1) {
+            throw std::invalid_argument(
+                    "'v' and 'm' must be greater than or equal to 1.");
+        }
+        for (Profit spanner_item_id = 0; spanner_item_id < v; ++spanner_item_id) {
+            Item item = generate_item(*this, random_generator);
+            item.profit = (2 * item.profit + m - 1) / m;
+            item.weight = (2 * item.weight + m - 1) / m;
+            spanner_items.push_back(item);
+        }
+    }
+
+    // Add items.
+    Weight weight_max = 0;
+    Weight weight_sum = 0;
+    for (ItemPos pos = 0; pos < n; ++pos) {
+        Item item;
+        if (spanner) {
+            std::uniform_int_distribution<Profit> distribution_spanner(0, v - 1);
+            std::uniform_int_distribution<Profit> distribution_multiplier(1, m);
+            item = spanner_items[distribution_spanner(random_generator)];
+            Profit multiplier = distribution_multiplier(random_generator);
+            item.profit *= multiplier;
+            item.weight *= multiplier;
+        } else {
+            item = generate_item(*this, random_generator);
+        }
+        instance_builder.add_item(item.profit, item.weight);
+
+        weight_max = std::max(weight_max, item.weight);
+        weight_sum += item.weight;
+    }
+
+    // Compute capacity.
+    double capacity_ratio = (x >= 0)?
+        x:
+        (double)h / (hmax + 1);
+    Weight capacity = std::max(
+            weight_max,
+            (Weight)(capacity_ratio * weight_sum));
+    instance_builder.set_capacity(capacity);
+
+    return instance_builder.build();
+}
+
+std::ostream& knapsacksolver::operator<<(
+        std::ostream& os,
+        const Generator& generator)
+{
+    os
+        << "Type: " << generator.t << std::endl
+        << "Number of items: " << generator.n << std::endl
+        << "R: " << generator.r << std::endl
+        << "k1: " << generator.k1 << std::endl
+        << "k2: " << generator.k2 << std::endl
+        << "d: " << generator.d << std::endl
+        << "h: " << generator.h << std::endl
+        << "hmax: " << generator.hmax << std::endl
+        << "x: " << generator.x << std::endl
+        << "Seed: " << generator.s << std::endl
+        << "Spanner: " << generator.spanner << std::endl
+        << "v: " << generator.v << std::endl
+        << "m: " << generator.m << std::endl
+        << "Normal: " << generator.normal << std::endl
+        << "dw: " << generator.dw << std::endl
+        ;
+    return os;
+}
+
+void knapsacksolver::generate_instances(
+        const Generator& generator,
+        Counter number_of_instances,
+        const std::string& output_directory,
+        const std::string& format,
+        int number_of_threads)
+{
+    if (format != "standard" && format != "binary") {
+        throw std::invalid_argument(
+                "Unknown instance format \"" + format + "\".");
+    }
+
+    std::atomic<Counter> next_instance_id(0);
+    std::mutex exception_mutex;
+    std::exception_ptr exception = nullptr;
+    auto worker = [
+        &generator,
+        number_of_instances,
+        &output_directory,
+        &format,
+        &next_instance_id,
+        &exception_mutex,
+        &exception]()
+    {
+        Generator instance_generator = generator;
+        for (;;) {
+            Counter instance_id = next_instance_id++;
+            if (instance_id >= number_of_instances)
+                break;
+            try {
+                instance_generator.s = generator.s + instance_id;
+                const Instance instance = instance_generator.generate();
+                std::string instance_path = output_directory + "/"
+                    + generator.t
+                    + "_" + std::to_string(generator.n)
+                    + "_" + std::to_string(generator.r)
+                    + "_" + std::to_string(instance_generator.s);
+                if (format == "binary") {
+                    instance.write_binary(instance_path + ".bin");
+                } else {
+                    instance.write(instance_path + ".txt");
+                }
+            } catch (...) {
+                // Stop all the threads and rethrow the exception once they
+                // are joined.
+                std::lock_guard<std::mutex> lock(exception_mutex);
+                if (exception == nullptr)
+                    exception = std::current_exception();
+                next_instance_id = number_of_instances;
+                break;
+            }
+        }
+    };
+
+    if (number_of_threads <= 0)
+        number_of_threads = (std::max)(1u, std::thread::hardware_concurrency());
+    std::vector<std::thread> threads;
+    for (int thread_id = 1; thread_id < number_of_threads; ++thread_id)
+        threads.push_back(std::thread(worker));
+    worker();
+    for (std::thread& thread: threads)
+        thread.join();
+    if (exception != nullptr)
+        std::rethrow_exception(exception);
+}
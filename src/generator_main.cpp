@@ -11,16 +11,19 @@ int main(int argc, char *argv[])
     // Parse program options
     Generator data;
     std::string output_file = "";
-    std::string plot_file = "";
+    Counter number_of_instances = 0;
+    std::string output_directory = ".";
+    std::string format = "standard";
+    int number_of_threads = 1;
     po::options_description desc("Allowed options");
     desc.add_options()
         ("help,h", "produce help message")
-        (",t", po::value<std::string>(&data.t)->required(), "set instancetance type (u, wc, sc, isc, asc, ss, sw, mstr, pceil, circle)")
-        (",n", po::value<ItemIdx>(&data.n)->required(), "set item number")
+        (",t", po::value<std::string>(&data.t)->required(), "set instance type (u, wc, sc, isc, asc, ss, sw, mstr, pceil, circle)")
+        (",n", po::value<ItemPos>(&data.n)->required(), "set item number")
         (",r", po::value<Profit>(&data.r), "set R")
-        ("ka", po::value<Profit>(&data.k1), "set k1 (for mstr instancetances)")
-        ("kb", po::value<Profit>(&data.k2), "set k2 (for mstr instancetances)")
-        (",d", po::value<double>(&data.d), "set d (for mstr (6), pceil (3) and circle (3/2) instancetances)")
+        ("ka", po::value<Profit>(&data.k1), "set k1 (for mstr instances)")
+        ("kb", po::value<Profit>(&data.k2), "set k2 (for mstr instances)")
+        (",d", po::value<double>(&data.d), "set d (for mstr (6), pceil (3) and circle (2/3) instances)")
         (",H", po::value<int>(&data.h), "set h")
         ("hmax", po::value<int>(&data.hmax), "set hmax")
         (",x", po::value<double>(&data.x), "set x")
@@ -28,10 +31,13 @@ int main(int argc, char *argv[])
         ("spanner", "set spanner")
         ("normal", "set normal")
         ("dw", po::value<double>(&data.dw), "set dw")
-        (",m", po::value<Profit>(&data.m), "set m (for spanner instancetances)")
-        (",v", po::value<Profit>(&data.v), "set v (for spanner instancetances)")
+        (",m", po::value<Profit>(&data.m), "set m (for spanner instances)")
+        (",v", po::value<Profit>(&data.v), "set v (for spanner instances)")
         (",o", po::value<std::string>(&output_file), "set output file")
-        (",p", po::value<std::string>(&plot_file), "set plot file")
+        ("number-of-instances", po::value<Counter>(&number_of_instances), "generate several instances with consecutive seeds")
+        ("output-directory", po::value<std::string>(&output_directory), "set output directory (with --number-of-instances)")
+        ("format", po::value<std::string>(&format), "set output format (standard, binary)")
+        ("threads", po::value<int>(&number_of_threads), "set number of threads (with --number-of-instances, 0: all cores)")
         ;
     po::variables_map vm;
     po::store(po::parse_command_line(argc, argv, desc), vm);
@@ -49,13 +55,25 @@ int main(int argc, char *argv[])
     data.normal = vm.count("normal");
 
     std::cout << data << std::endl;
-    Instance instance = data.generate();
 
-    if (plot_file != "")
-        instance.plot(plot_file);
-    if (output_file != "")
-        instance.write(output_file);
+    if (number_of_instances > 0) {
+        generate_instances(
+                data,
+                number_of_instances,
+                output_directory,
+                format,
+                number_of_threads);
+        return 0;
+    }
+
+    Instance instance = data.generate();
+    if (output_file != "") {
+        if (format == "binary") {
+            instance.write_binary(output_file);
+        } else {
+            instance.write(output_file);
+        }
+    }
 
     return 0;
 }
-
@@ -1,5 +1,6 @@
 #include "knapsacksolver/instance.hpp"
 
+#include <algorithm>
 #include <fstream>
 #include <iomanip>
 
@@ -60,3 +61,44 @@ void Instance::write(
         file << item(item_id).profit << " " << item(item_id).weight << std::endl;
     }
 }
+
+void Instance::write_binary(
+        std::string instance_path) const
+{
+    std::ofstream file(instance_path, std::ios::binary);
+    if (!file.good()) {
+        throw std::runtime_error(
+                "Unable to open file \"" + instance_path + "\".");
+    }
+
+    InstanceBinaryHeader header;
+    std::copy(
+            instance_binary_magic,
+            instance_binary_magic + sizeof(header.magic),
+            header.magic);
+    header.version = instance_binary_version;
+    header.padding = 0;
+    header.number_of_items = number_of_items();
+    header.capacity = capacity();
+    header.total_item_profit = total_item_profit();
+    header.total_item_weight = total_item_weight();
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    // Write columns.
+    std::vector<int64_t> column(number_of_items());
+    for (ItemId item_id = 0; item_id < number_of_items(); ++item_id)
+        column[item_id] = item(item_id).profit;
+    file.write(
+            reinterpret_cast<const char*>(column.data()),
+            column.size() * sizeof(int64_t));
+    for (ItemId item_id = 0; item_id < number_of_items(); ++item_id)
+        column[item_id] = item(item_id).weight;
+    file.write(
+            reinterpret_cast<const char*>(column.data()),
+            column.size() * sizeof(int64_t));
+
+    if (!file.good()) {
+        throw std::runtime_error(
+                "Unable to write file \"" + instance_path + "\".");
+    }
+}
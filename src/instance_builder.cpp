@@ -1,8 +1,18 @@
 #include "knapsacksolver/instance_builder.hpp"
 
-#include "optimizationtools/utils/utils.hpp"
-
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <fstream>
+#include <limits>
+#include <stdexcept>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 using namespace knapsacksolver;
 
@@ -16,93 +26,329 @@ void InstanceBuilder::add_item(
     instance_.items_.push_back(item);
 };
 
+void InstanceBuilder::add_items(
+        const Profit* profits,
+        const Weight* weights,
+        ItemId number_of_items)
+{
+    ItemId offset = instance_.items_.size();
+    instance_.items_.resize(offset + number_of_items);
+    for (ItemId item_id = 0; item_id < number_of_items; ++item_id) {
+        Item& item = instance_.items_[offset + item_id];
+        item.profit = profits[item_id];
+        item.weight = weights[item_id];
+    }
+}
+
+namespace
+{
+
+/**
+ * Parser for instance files in text formats.
+ *
+ * The whole file is read into a buffer, and integers are parsed directly
+ * from it without creating any intermediate string.
+ */
+class TextParser
+{
+
+public:
+
+    /** Constructor. */
+    TextParser(const std::string& data):
+        current_(data.data()),
+        end_(data.data() + data.size()) { }
+
+    /** Skip the next token. */
+    void skip_token()
+    {
+        skip_spaces();
+        while (current_ != end_ && !is_space(*current_))
+            ++current_;
+    }
+
+    /** Skip the end of the current line. */
+    void skip_line()
+    {
+        while (current_ != end_ && *current_ != '\n')
+            ++current_;
+    }
+
+    /**
+     * Get an upper bound on the number of integers left in the buffer.
+     *
+     * Each integer takes at least one digit and one separator, so that the
+     * number of items announced by a file can be checked before reserving
+     * memory for them.
+     */
+    int64_t maximum_number_of_integers() const
+    {
+        return (end_ - current_ + 1) / 2;
+    }
+
+    /**
+     * Read the next integer.
+     *
+     * Spaces and commas before the integer are skipped. Throw an
+     * 'std::invalid_argument' if the integer doesn't fit in 64 bits.
+     */
+    int64_t read_integer()
+    {
+        while (current_ != end_ && (is_space(*current_) || *current_ == ','))
+            ++current_;
+        bool negative = false;
+        if (current_ != end_ && *current_ == '-') {
+            negative = true;
+            ++current_;
+        }
+        if (current_ == end_ || *current_ < '0' || *current_ > '9') {
+            throw std::invalid_argument(
+                    "Unable to read an integer from the instance file.");
+        }
+        // The absolute value of the smallest integer is one more than the
+        // largest one.
+        uint64_t maximum_value = (uint64_t)std::numeric_limits<int64_t>::max()
+            + ((negative)? 1: 0);
+        uint64_t value = 0;
+        while (current_ != end_ && *current_ >= '0' && *current_ <= '9') {
+            uint64_t digit = *current_ - '0';
+            if (value > (maximum_value - digit) / 10) {
+                throw std::invalid_argument(
+                        "Integer too large in the instance file.");
+            }
+            value = 10 * value + digit;
+            ++current_;
+        }
+        return (negative)? (int64_t)(0 - value): (int64_t)value;
+    }
+
+private:
+
+    /** Return 'true' iff a character is a space. */
+    static bool is_space(char c) { return c == ' ' || c == '\n' || c == '\r' || c == '\t'; }
+
+    /** Skip the spaces. */
+    void skip_spaces()
+    {
+        while (current_ != end_ && is_space(*current_))
+            ++current_;
+    }
+
+    /** Current position in the buffer. */
+    const char* current_;
+
+    /** End of the buffer. */
+    const char* end_;
+
+};
+
+}
+
 void InstanceBuilder::read(
         const std::string& instance_path,
         const std::string& format)
 {
-    std::ifstream file(instance_path);
+    if (format == "binary") {
+        read_binary(instance_path);
+        return;
+    }
+
+    std::ifstream file(instance_path, std::ios::binary | std::ios::ate);
     if (!file.good()) {
         throw std::runtime_error(
                 "Unable to open file \"" + instance_path + "\".");
     }
 
+    // Read the whole file.
+    std::string data(file.tellg(), '\0');
+    file.seekg(0);
+    file.read(&data[0], data.size());
+    file.close();
+
     if (format == "standard" || format == "") {
-        read_standard(file);
+        read_standard(data);
     } else if (format == "pisinger") {
-        read_pisinger(file);
+        read_pisinger(data);
     } else if (format == "jooken") {
-        read_jooken(file);
+        read_jooken(data);
     } else if (format == "subset_sum_standard") {
-        read_subset_sum_standard(file);
+        read_subset_sum_standard(data);
     } else {
         throw std::invalid_argument(
                 "Unknown instance format \"" + format + "\".");
     }
-
-    file.close();
 }
 
-void InstanceBuilder::read_standard(std::ifstream& file)
+void InstanceBuilder::read_standard(const std::string& data)
 {
-    ItemId number_of_items;
-    Weight weight;
-    Profit profit;
-    file >> number_of_items >> weight;
-    set_capacity(weight);
+    TextParser parser(data);
+    ItemId number_of_items = parser.read_integer();
+    set_capacity(parser.read_integer());
+    reserve(instance_.items_.size() + (std::max)((ItemId)0, (std::min)(
+                    number_of_items,
+                    parser.maximum_number_of_integers())));
     for (ItemPos item_id = 0; item_id < number_of_items; ++item_id) {
-        file >> profit >> weight;
+        Profit profit = parser.read_integer();
+        Weight weight = parser.read_integer();
         add_item(profit, weight);
     }
 }
 
-void InstanceBuilder::read_pisinger(std::ifstream& file)
+void InstanceBuilder::read_pisinger(const std::string& data)
 {
-    ItemId number_of_items;
-    Weight capacity;
-    std::string tmp;
-    file >> tmp >> tmp >> number_of_items >> tmp >> capacity >> tmp >> tmp >> tmp >> tmp;
-    set_capacity(capacity);
-
-    getline(file, tmp);
+    TextParser parser(data);
+    parser.skip_token();
+    parser.skip_token();
+    ItemId number_of_items = parser.read_integer();
+    parser.skip_token();
+    set_capacity(parser.read_integer());
+    parser.skip_token();
+    parser.skip_token();
+    parser.skip_token();
+    parser.skip_token();
+    reserve(instance_.items_.size() + (std::max)((ItemId)0, (std::min)(
+                    number_of_items,
+                    parser.maximum_number_of_integers())));
     for (ItemPos item_id = 0; item_id < number_of_items; ++item_id) {
-        getline(file, tmp);
-        std::vector<std::string> line = optimizationtools::split(tmp, ',');
-        Profit profit = std::stol(line[1]);
-        Weight weight = std::stol(line[2]);
+        parser.read_integer();
+        Profit profit = parser.read_integer();
+        Weight weight = parser.read_integer();
+        parser.skip_line();
         add_item(profit, weight);
     }
 }
 
-void InstanceBuilder::read_jooken(std::ifstream& file)
+void InstanceBuilder::read_jooken(const std::string& data)
 {
-    ItemId number_of_items;
-    file >> number_of_items;
-
-    ItemId tmp;
-    Weight weight;
-    Profit profit;
+    TextParser parser(data);
+    ItemId number_of_items = parser.read_integer();
+    reserve(instance_.items_.size() + (std::max)((ItemId)0, (std::min)(
+                    number_of_items,
+                    parser.maximum_number_of_integers())));
     for (ItemPos item_id = 0; item_id < number_of_items; ++item_id) {
-        file >> tmp >> profit >> weight;
+        parser.read_integer();
+        Profit profit = parser.read_integer();
+        Weight weight = parser.read_integer();
         add_item(profit, weight);
     }
+    set_capacity(parser.read_integer());
+}
 
-    Weight capacity;
-    file >> capacity;
-    set_capacity(capacity);
+void InstanceBuilder::read_subset_sum_standard(const std::string& data)
+{
+    TextParser parser(data);
+    ItemId number_of_items = parser.read_integer();
+    set_capacity(parser.read_integer());
+    reserve(instance_.items_.size() + (std::max)((ItemId)0, (std::min)(
+                    number_of_items,
+                    parser.maximum_number_of_integers())));
+    for (ItemId item_id = 0; item_id < number_of_items; ++item_id) {
+        Weight weight = parser.read_integer();
+        add_item(weight, weight);
+    }
 }
 
-void InstanceBuilder::read_subset_sum_standard(std::ifstream& file)
+void InstanceBuilder::read_binary(const std::string& instance_path)
 {
-    ItemId number_of_items;
-    Weight capacity;
-    file >> number_of_items >> capacity;
+#ifdef _WIN32
+    std::ifstream file(instance_path, std::ios::binary | std::ios::ate);
+    if (!file.good()) {
+        throw std::runtime_error(
+                "Unable to open file \"" + instance_path + "\".");
+    }
+    std::size_t size = file.tellg();
+    file.seekg(0);
+    std::vector<char> buffer(size);
+    file.read(buffer.data(), size);
+    read_binary(buffer.data(), size);
+#else
+    int fd = open(instance_path.c_str(), O_RDONLY);
+    if (fd == -1) {
+        throw std::runtime_error(
+                "Unable to open file \"" + instance_path + "\".");
+    }
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) == -1) {
+        close(fd);
+        throw std::runtime_error(
+                "Unable to read file \"" + instance_path + "\".");
+    }
+    std::size_t size = file_stat.st_size;
+    if (size < sizeof(InstanceBinaryHeader)) {
+        close(fd);
+        throw std::invalid_argument(
+                "File \"" + instance_path + "\" is not a binary instance file.");
+    }
+    void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        throw std::runtime_error(
+                "Unable to map file \"" + instance_path + "\".");
+    }
+    madvise(data, size, MADV_SEQUENTIAL);
+    try {
+        read_binary(static_cast<const char*>(data), size);
+    } catch (...) {
+        munmap(data, size);
+        throw;
+    }
+    munmap(data, size);
+#endif
+}
 
-    set_capacity(capacity);
+void InstanceBuilder::read_binary(
+        const char* data,
+        std::size_t size)
+{
+    // Read header.
+    InstanceBinaryHeader header;
+    if (size < sizeof(header)) {
+        throw std::invalid_argument(
+                "Binary instance: the file is too small.");
+    }
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, instance_binary_magic, sizeof(header.magic)) != 0) {
+        throw std::invalid_argument(
+                "Binary instance: wrong magic number.");
+    }
+    if (header.version != instance_binary_version) {
+        throw std::invalid_argument(
+                "Binary instance: unsupported version "
+                + std::to_string(header.version) + ".");
+    }
+    if (header.number_of_items < 0
+            || (size - sizeof(header)) / (2 * sizeof(int64_t))
+            != (std::size_t)header.number_of_items
+            || (size - sizeof(header)) % (2 * sizeof(int64_t)) != 0) {
+        throw std::invalid_argument(
+                "Binary instance: the file size doesn't match the number of items.");
+    }
 
-    Weight weight = -1;
+    // Read columns.
+    set_capacity(header.capacity);
+    ItemId number_of_items = header.number_of_items;
+    ItemId offset = instance_.items_.size();
+    instance_.items_.resize(offset + number_of_items);
+    const char* profits = data + sizeof(header);
+    const char* weights = profits + number_of_items * sizeof(int64_t);
+    // The totals are computed modulo 2^64, so that a corrupted file can't
+    // overflow them; they match the header for any valid instance.
+    uint64_t total_item_profit = 0;
+    uint64_t total_item_weight = 0;
     for (ItemId item_id = 0; item_id < number_of_items; ++item_id) {
-        file >> weight;
-        add_item(weight, weight);
+        Item& item = instance_.items_[offset + item_id];
+        std::memcpy(&item.profit, profits + item_id * sizeof(int64_t), sizeof(int64_t));
+        std::memcpy(&item.weight, weights + item_id * sizeof(int64_t), sizeof(int64_t));
+        total_item_profit += (uint64_t)item.profit;
+        total_item_weight += (uint64_t)item.weight;
+    }
+
+    // Check the totals of the header.
+    if (total_item_profit != (uint64_t)header.total_item_profit
+            || total_item_weight != (uint64_t)header.total_item_weight) {
+        instance_.items_.resize(offset);
+        throw std::invalid_argument(
+                "Binary instance: the totals of the items don't match the header.");
     }
 }
 
@@ -114,12 +360,16 @@ Instance InstanceBuilder::build()
                 "The knapsack capacity must be positive.");
     }
 
-    // Check that profit are positive and weights are positive and smaller than
-    // the capacity. Also compute the highest item weight, needed below.
+    // Single pass over the items to check that profits are positive and
+    // weights are positive and smaller than the capacity, and to compute the
+    // highest item profit and weight, the total item profit and weight, the
+    // item efficiencies and the item with the highest efficiency.
+    instance_.highest_efficiency_item_id_ = -1;
+    double highest_efficiency = 0.0;
     for (ItemId item_id = 0;
             item_id < instance_.number_of_items();
             ++item_id) {
-        const Item& item = instance_.items_[item_id];
+        Item& item = instance_.items_[item_id];
         if (item.profit <= 0) {
             throw std::invalid_argument(
                     "Items must have strictly positive profits.");
@@ -133,38 +383,9 @@ Instance InstanceBuilder::build()
                     "The weight of an item must be smaller than the knapsack capacity..");
         }
         instance_.highest_item_weight_ = std::max(instance_.highest_item_weight_, item.weight);
-    }
-
-    // Check no overflow because of the bounds computed by 'upper_bound' and
-    // 'upper_bound_reverse', which multiply an item's profit by a weight gap
-    // that can be as large as 'capacity + 2 * highest_item_weight' (the
-    // weight of a state can exceed the capacity by up to two item weights,
-    // see PartialSort::sort_next_right_interval).
-    Weight bound_weight = instance_.capacity();
-    if (instance_.highest_item_weight_
-            > (std::numeric_limits<Weight>::max() - bound_weight) / 2) {
-        throw std::overflow_error(
-                "Overflow while computing the profit/weight bound.");
-    }
-    bound_weight += 2 * instance_.highest_item_weight_;
-    for (ItemId item_id = 0;
-            item_id < instance_.number_of_items();
-            ++item_id) {
-        const Item& item = instance_.items_[item_id];
-        if (bound_weight > 0
-                && item.profit > std::numeric_limits<Profit>::max() / bound_weight) {
-            throw std::overflow_error(
-                    "Overflow: 'item.profit * (capacity + 2 * highest_item_weight)' "
-                    "must not exceed the maximum profit value.");
-        }
-    }
-
-    // Compute total item profit and weight.
-    for (ItemId item_id = 0;
-            item_id < instance_.number_of_items();
-            ++item_id) {
-        const Item& item = instance_.items_[item_id];
         instance_.highest_item_profit_ = std::max(instance_.highest_item_profit_, item.profit);
+
+        // Compute total item profit and weight.
         if (item.profit > std::numeric_limits<Profit>::max() - instance_.total_item_profit_) {
             throw std::overflow_error(
                     "Overflow while computing the total item profit.");
@@ -175,29 +396,36 @@ Instance InstanceBuilder::build()
                     "Overflow while computing the total item weight.");
         }
         instance_.total_item_weight_ += item.weight;
-    }
 
-    // Compute item efficiencies.
-    for (ItemId item_id = 0;
-            item_id < instance_.number_of_items();
-            ++item_id) {
-        Item& item = instance_.items_[item_id];
+        // Compute item efficiency.
         item.efficiency = (double)item.profit / item.weight;
-    }
-
-    // Compute highest efficiency item.
-    instance_.highest_efficiency_item_id_ = -1;
-    for (ItemId item_id = 0;
-            item_id < instance_.number_of_items();
-            ++item_id) {
-        const Item& item = instance_.item(item_id);
         if (instance_.highest_efficiency_item_id_ == -1
-                || item.efficiency
-                > instance_.item(instance_.highest_efficiency_item_id_).efficiency) {
+                || item.efficiency > highest_efficiency) {
             instance_.highest_efficiency_item_id_ = item_id;
+            highest_efficiency = item.efficiency;
         }
     }
 
+    // Check no overflow because of the bounds computed by 'upper_bound' and
+    // 'upper_bound_reverse', which multiply an item's profit by a weight gap
+    // that can be as large as 'capacity + 2 * highest_item_weight' (the
+    // weight of a state can exceed the capacity by up to two item weights,
+    // see PartialSort::sort_next_right_interval). Checking the highest item
+    // profit is enough.
+    Weight bound_weight = instance_.capacity();
+    if (instance_.highest_item_weight_
+            > (std::numeric_limits<Weight>::max() - bound_weight) / 2) {
+        throw std::overflow_error(
+                "Overflow while computing the profit/weight bound.");
+    }
+    bound_weight += 2 * instance_.highest_item_weight_;
+    if (bound_weight > 0
+            && instance_.highest_item_profit_ > std::numeric_limits<Profit>::max() / bound_weight) {
+        throw std::overflow_error(
+                "Overflow: 'item.profit * (capacity + 2 * highest_item_weight)' "
+                "must not exceed the maximum profit value.");
+    }
+
     return std::move(instance_);
 }
 
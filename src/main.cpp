@@ -1,21 +1,51 @@
 #include "knapsacksolver/instance_builder.hpp"
+#include "knapsacksolver/batch.hpp"
+#include "knapsacksolver/features.hpp"
 
 #include "knapsacksolver/upper_bound.hpp"
 #include "knapsacksolver/algorithms/upper_bound_dantzig.hpp"
 #include "knapsacksolver/algorithms/greedy.hpp"
 #include "knapsacksolver/algorithms/dynamic_programming_bellman.hpp"
 #include "knapsacksolver/algorithms/dynamic_programming_primal_dual.hpp"
+#include "knapsacksolver/algorithms/portfolio.hpp"
+
+#ifndef _WIN32
+#include "knapsacksolver/server.hpp"
+#endif
 
 #include <boost/program_options.hpp>
 
+#include <csignal>
+#include <fstream>
+#include <mutex>
+
 using namespace knapsacksolver;
 
 namespace po = boost::program_options;
 
+void write_certificate(
+        const Solution& solution,
+        const std::string& certificate_path,
+        const std::string& certificate_format)
+{
+    if (certificate_format == "binary") {
+        solution.write_binary(certificate_path);
+    } else if (certificate_format == "standard" || certificate_format == "") {
+        solution.write(certificate_path);
+    } else {
+        throw std::invalid_argument(
+                "Unknown certificate format \"" + certificate_format + "\".");
+    }
+}
+
 void read_args(
         Parameters& parameters,
-        const po::variables_map& vm)
+        const po::variables_map& vm,
+        const Solution& initial_solution,
+        const AlgorithmSelection& selection)
 {
+    if (!selection.algorithm.empty())
+        parameters.algorithm_selection = &selection;
     parameters.timer.set_sigint_handler();
     parameters.messages_to_stdout = true;
     if (vm.count("time-limit"))
@@ -26,17 +56,30 @@ void read_args(
         parameters.log_path = vm["log"].as<std::string>();
     parameters.log_to_stderr = vm.count("log-to-stderr");
     parameters.json_output = (vm.count("output"));
+    if (!vm["initial-solution"].as<std::string>().empty())
+        parameters.initial_solution = &initial_solution;
+    if (vm.count("lower-bound"))
+        parameters.lower_bound = vm["lower-bound"].as<Profit>();
+    if (vm.count("memory-limit"))
+        parameters.memory_limit = (Counter)(vm["memory-limit"].as<double>() * 1024 * 1024);
+    parameters.statistics = vm.count("statistics");
+    parameters.performance_counters = vm.count("performance-counters");
     bool only_write_at_the_end = vm.count("only-write-at-the-end");
     if (!only_write_at_the_end) {
         std::string certificate_path = vm["certificate"].as<std::string>();
+        std::string certificate_format = vm["certificate-format"].as<std::string>();
         std::string json_output_path = vm["output"].as<std::string>();
         parameters.new_solution_callback = [
             json_output_path,
-            certificate_path](
+            certificate_path,
+            certificate_format](
                     const Output& output)
         {
             output.write_json_output(json_output_path);
-            output.solution.write(certificate_path);
+            write_certificate(
+                    output.solution,
+                    certificate_path,
+                    certificate_format);
         };
     }
 }
@@ -46,56 +89,80 @@ Output run(
         const po::variables_map& vm)
 {
     std::mt19937_64 generator(vm["seed"].as<Seed>());
-    Solution solution(instance, vm["initial-solution"].as<std::string>());
+    Solution initial_solution(
+            instance,
+            vm["initial-solution"].as<std::string>(),
+            vm["certificate-format"].as<std::string>());
 
     // Run algorithm.
     std::string algorithm = "dynamic-programming-primal-dual";
     if (vm.count("algorithm"))
         algorithm = vm["algorithm"].as<std::string>();
 
+    // Select the algorithm from the features of the instance.
+    AlgorithmSelection selection;
+    if (algorithm == "auto") {
+        selection = select_algorithm(compute_features(instance));
+        algorithm = selection.algorithm;
+    }
+
     if (algorithm == "upper-bound-dantzig") {
         UpperBoundDantzigParameters parameters;
-        read_args(parameters, vm);
+        read_args(parameters, vm, initial_solution, selection);
         return upper_bound_dantzig(instance, parameters);
 
     } else if (algorithm == "greedy") {
         GreedyParameters parameters;
-        read_args(parameters, vm);
+        read_args(parameters, vm, initial_solution, selection);
+        if (vm.count("extended"))
+            parameters.extended = vm["extended"].as<bool>();
         return greedy(instance, parameters);
 
     } else if (algorithm == "dynamic-programming-bellman-rec") {
         Parameters parameters;
-        read_args(parameters, vm);
+        read_args(parameters, vm, initial_solution, selection);
         return dynamic_programming_bellman_rec(instance, parameters);
     } else if (algorithm == "dynamic-programming-bellman-array") {
         Parameters parameters;
-        read_args(parameters, vm);
+        read_args(parameters, vm, initial_solution, selection);
         return dynamic_programming_bellman_array(instance, parameters);
     } else if (algorithm == "dynamic-programming-bellman-array-parallel") {
         Parameters parameters;
-        read_args(parameters, vm);
+        read_args(parameters, vm, initial_solution, selection);
         return dynamic_programming_bellman_array_parallel(instance, parameters);
     } else if (algorithm == "dynamic-programming-bellman-array-all") {
         Parameters parameters;
-        read_args(parameters, vm);
+        read_args(parameters, vm, initial_solution, selection);
         return dynamic_programming_bellman_array_all(instance, parameters);
+    } else if (algorithm == "dynamic-programming-bellman-array-disk") {
+        DynamicProgrammingBellmanArrayDiskParameters parameters;
+        read_args(parameters, vm, initial_solution, selection);
+        if (vm.count("decision-directory"))
+            parameters.decision_directory = vm["decision-directory"].as<std::string>();
+        return dynamic_programming_bellman_array_disk(instance, parameters);
     } else if (algorithm == "dynamic-programming-bellman-array-one") {
-        Parameters parameters;
-        read_args(parameters, vm);
+        DynamicProgrammingBellmanArrayOneParameters parameters;
+        read_args(parameters, vm, initial_solution, selection);
+        if (vm.count("checkpoint"))
+            parameters.checkpoint_path = vm["checkpoint"].as<std::string>();
+        if (vm.count("checkpoint-interval"))
+            parameters.checkpoint_interval = vm["checkpoint-interval"].as<double>();
+        if (vm.count("resume"))
+            parameters.resume = true;
         return dynamic_programming_bellman_array_one(instance, parameters);
     } else if (algorithm == "dynamic-programming-bellman-array-part") {
         DynamicProgrammingBellmanArrayPartParameters parameters;
-        read_args(parameters, vm);
+        read_args(parameters, vm, initial_solution, selection);
         if (vm.count("partial-solution-size"))
             parameters.partial_solution_size = vm["partial-solution-size"].as<int>();
         return dynamic_programming_bellman_array_part(instance, parameters);
     } else if (algorithm == "dynamic-programming-bellman-array-rec") {
         Parameters parameters;
-        read_args(parameters, vm);
+        read_args(parameters, vm, initial_solution, selection);
         return dynamic_programming_bellman_array_rec(instance, parameters);
     } else if (algorithm == "dynamic-programming-bellman-list") {
         DynamicProgrammingBellmanListParameters parameters;
-        read_args(parameters, vm);
+        read_args(parameters, vm, initial_solution, selection);
         if (vm.count("sort"))
             parameters.sort = vm["sort"].as<bool>();
         return dynamic_programming_bellman_list(instance, parameters);
@@ -103,19 +170,357 @@ Output run(
     } else if (algorithm == "dynamic-programming-primal-dual"
             || algorithm == "minknap") {
         DynamicProgrammingPrimalDualParameters parameters;
-        read_args(parameters, vm);
+        read_args(parameters, vm, initial_solution, selection);
         if (vm.count("partial-solution-size"))
             parameters.partial_solution_size = vm["partial-solution-size"].as<int>();
+        parameters.pairing = selection.pairing;
         if (vm.count("pairing"))
             parameters.pairing = vm["pairing"].as<bool>();
+        if (vm.count("checkpoint"))
+            parameters.checkpoint_path = vm["checkpoint"].as<std::string>();
+        if (vm.count("checkpoint-interval"))
+            parameters.checkpoint_interval = vm["checkpoint-interval"].as<double>();
+        if (vm.count("resume"))
+            parameters.resume = true;
         return dynamic_programming_primal_dual(instance, parameters);
 
+    } else if (algorithm == "portfolio") {
+        PortfolioParameters parameters;
+        read_args(parameters, vm, initial_solution, selection);
+        return portfolio(instance, parameters);
+
     } else {
         throw std::invalid_argument(
                 "Unknown algorithm \"" + algorithm + "\".");
     }
 }
 
+/**
+ * Get the algorithm solving each instance in the batch and server modes.
+ *
+ * The default primal-dual algorithm is handled by these modes themselves.
+ */
+std::function<Output(const Instance&, const Parameters&)> pool_algorithm(
+        const std::string& algorithm,
+        const std::string& mode,
+        const po::variables_map& vm)
+{
+    if (algorithm == "upper-bound-dantzig") {
+        return [](const Instance& instance, const Parameters& parameters)
+        {
+            return upper_bound_dantzig(
+                    instance,
+                    portfolio_algorithm_parameters<UpperBoundDantzigParameters>(parameters));
+        };
+    } else if (algorithm == "greedy") {
+        return [](const Instance& instance, const Parameters& parameters)
+        {
+            return greedy(
+                    instance,
+                    portfolio_algorithm_parameters<GreedyParameters>(parameters));
+        };
+    } else if (algorithm == "dynamic-programming-bellman-rec") {
+        return [](const Instance& instance, const Parameters& parameters)
+        {
+            return dynamic_programming_bellman_rec(instance, parameters);
+        };
+    } else if (algorithm == "dynamic-programming-bellman-array") {
+        return [](const Instance& instance, const Parameters& parameters)
+        {
+            return dynamic_programming_bellman_array(instance, parameters);
+        };
+    } else if (algorithm == "dynamic-programming-bellman-array-parallel") {
+        return [](const Instance& instance, const Parameters& parameters)
+        {
+            return dynamic_programming_bellman_array_parallel(instance, parameters);
+        };
+    } else if (algorithm == "dynamic-programming-bellman-array-all") {
+        return [](const Instance& instance, const Parameters& parameters)
+        {
+            return dynamic_programming_bellman_array_all(instance, parameters);
+        };
+    } else if (algorithm == "dynamic-programming-bellman-array-disk") {
+        std::string decision_directory;
+        if (vm.count("decision-directory"))
+            decision_directory = vm["decision-directory"].as<std::string>();
+        return [decision_directory](const Instance& instance, const Parameters& parameters)
+        {
+            auto disk_parameters = portfolio_algorithm_parameters<
+                DynamicProgrammingBellmanArrayDiskParameters>(parameters);
+            disk_parameters.decision_directory = decision_directory;
+            return dynamic_programming_bellman_array_disk(instance, disk_parameters);
+        };
+    } else if (algorithm == "dynamic-programming-bellman-array-one") {
+        return [](const Instance& instance, const Parameters& parameters)
+        {
+            return dynamic_programming_bellman_array_one(
+                    instance,
+                    portfolio_algorithm_parameters<DynamicProgrammingBellmanArrayOneParameters>(parameters));
+        };
+    } else if (algorithm == "dynamic-programming-bellman-array-part") {
+        return [](const Instance& instance, const Parameters& parameters)
+        {
+            return dynamic_programming_bellman_array_part(
+                    instance,
+                    portfolio_algorithm_parameters<DynamicProgrammingBellmanArrayPartParameters>(parameters));
+        };
+    } else if (algorithm == "dynamic-programming-bellman-array-rec") {
+        return [](const Instance& instance, const Parameters& parameters)
+        {
+            return dynamic_programming_bellman_array_rec(instance, parameters);
+        };
+    } else if (algorithm == "dynamic-programming-bellman-list") {
+        return [](const Instance& instance, const Parameters& parameters)
+        {
+            return dynamic_programming_bellman_list(
+                    instance,
+                    portfolio_algorithm_parameters<DynamicProgrammingBellmanListParameters>(parameters));
+        };
+    } else if (algorithm == "auto") {
+        return [](const Instance& instance, const Parameters& parameters) -> Output
+        {
+            AlgorithmSelection selection = select_algorithm(
+                    compute_features(instance));
+            if (selection.algorithm == "greedy") {
+                return greedy(
+                        instance,
+                        portfolio_algorithm_parameters<GreedyParameters>(parameters));
+            } else if (selection.algorithm == "dynamic-programming-bellman-array-rec") {
+                return dynamic_programming_bellman_array_rec(instance, parameters);
+            }
+            auto primal_dual_parameters = portfolio_algorithm_parameters<
+                DynamicProgrammingPrimalDualParameters>(parameters);
+            primal_dual_parameters.pairing = selection.pairing;
+            return dynamic_programming_primal_dual(
+                    instance,
+                    primal_dual_parameters);
+        };
+    } else if (algorithm == "portfolio") {
+        return [](const Instance& instance, const Parameters& parameters)
+        {
+            return portfolio(
+                    instance,
+                    portfolio_algorithm_parameters<PortfolioParameters>(parameters));
+        };
+    } else {
+        throw std::invalid_argument(
+                "Algorithm \"" + algorithm + "\" is not available in " + mode + " mode.");
+    }
+}
+
+int run_batch(const po::variables_map& vm)
+{
+    BatchParameters parameters;
+    if (vm.count("threads"))
+        parameters.number_of_threads = vm["threads"].as<int>();
+    if (vm.count("time-limit"))
+        parameters.time_limit = vm["time-limit"].as<double>();
+    if (vm.count("memory-limit"))
+        parameters.memory_limit = (Counter)(vm["memory-limit"].as<double>() * 1024 * 1024);
+    std::string algorithm = "dynamic-programming-primal-dual";
+    if (vm.count("algorithm"))
+        algorithm = vm["algorithm"].as<std::string>();
+    if (algorithm != "dynamic-programming-primal-dual"
+            && algorithm != "minknap") {
+        parameters.algorithm = pool_algorithm(algorithm, "batch", vm);
+    }
+
+    bool json_lines = vm.count("json-lines");
+    bool json_lines_solution = vm.count("json-lines-solution");
+    int verbosity_level = (json_lines)? 0: 1;
+    if (vm.count("verbosity-level") && !json_lines)
+        verbosity_level = vm["verbosity-level"].as<int>();
+    std::string json_output_path = vm["output"].as<std::string>();
+
+    // Results kept for the JSON output, without the instances.
+    std::vector<std::string> instance_paths;
+    std::vector<nlohmann::json> values;
+    std::vector<nlohmann::json> bounds;
+    nlohmann::json errors = nlohmann::json::array();
+    bool memory_limit_exceeded_found = false;
+    std::mutex output_mutex;
+    auto record = [&instance_paths, &values, &bounds](
+            const BatchEntry& entry,
+            const nlohmann::json& value,
+            const nlohmann::json& bound)
+    {
+        if (instance_paths.size() <= entry.position) {
+            instance_paths.resize(entry.position + 1);
+            values.resize(entry.position + 1);
+            bounds.resize(entry.position + 1);
+        }
+        instance_paths[entry.position] = entry.name;
+        values[entry.position] = value;
+        bounds[entry.position] = bound;
+    };
+
+    // Write the result of each instance as soon as it is solved, with one JSON
+    // line per instance in JSON lines mode.
+    parameters.new_output_callback = [
+        json_lines,
+        json_lines_solution,
+        verbosity_level,
+        &json_output_path,
+        &record,
+        &output_mutex](
+                const BatchEntry& entry,
+                const Output& output)
+    {
+        nlohmann::json json {
+            {"Index", entry.position},
+            {"Instance", entry.name},
+            {"Value", output.value},
+            {"Bound", output.bound},
+            {"Time", output.time}};
+        if (json_lines_solution) {
+            std::vector<ItemId> item_ids;
+            for (ItemId item_id = 0;
+                    item_id < output.solution.instance().number_of_items();
+                    ++item_id) {
+                if (output.solution.contains(item_id))
+                    item_ids.push_back(item_id);
+            }
+            json["Solution"] = item_ids;
+        }
+        std::lock_guard<std::mutex> lock(output_mutex);
+        if (json_lines) {
+            std::cout << json.dump() << std::endl;
+        } else if (verbosity_level >= 2) {
+            std::cout << entry.name << " " << output.value << std::endl;
+        }
+        if (!json_output_path.empty())
+            record(entry, output.value, output.bound);
+    };
+
+    // Report the lines which can't be read and the instances which can't be
+    // solved, and keep solving the others.
+    parameters.error_callback = [
+        json_lines,
+        &json_output_path,
+        &record,
+        &errors,
+        &memory_limit_exceeded_found,
+        &output_mutex](
+                const BatchEntry& entry,
+                const std::exception& e)
+    {
+        nlohmann::json json {
+            {"Index", entry.position},
+            {"Line", entry.line_number},
+            {"Instance", entry.name},
+            {"Error", e.what()}};
+        // The memory limit errors are written as in the single instance mode.
+        const MemoryLimitExceeded* memory_limit_exceeded
+            = dynamic_cast<const MemoryLimitExceeded*>(&e);
+        if (memory_limit_exceeded != nullptr)
+            json["Error"] = memory_limit_exceeded->to_json();
+        std::lock_guard<std::mutex> lock(output_mutex);
+        if (memory_limit_exceeded != nullptr)
+            memory_limit_exceeded_found = true;
+        if (json_lines) {
+            std::cout << json.dump() << std::endl;
+        } else {
+            std::cerr
+                << "Error: line " << entry.line_number
+                << " (" << entry.name << "): " << e.what() << std::endl;
+        }
+        if (!json_output_path.empty()) {
+            record(entry, nullptr, nullptr);
+            errors.push_back(json);
+        }
+    };
+
+    // Run.
+    std::string batch_path = vm["batch"].as<std::string>();
+    BatchOutput output;
+    if (batch_path == "-") {
+        output = solve_batch_manifest(
+                std::cin,
+                vm["format"].as<std::string>(),
+                parameters);
+    } else {
+        std::ifstream batch_file(batch_path);
+        if (!batch_file.good()) {
+            throw std::runtime_error(
+                    "Unable to open file \"" + batch_path + "\".");
+        }
+        output = solve_batch_manifest(
+                batch_file,
+                vm["format"].as<std::string>(),
+                parameters);
+    }
+
+    // Write outputs.
+    if (verbosity_level >= 1)
+        output.format(std::cout);
+    if (!json_output_path.empty()) {
+        std::ofstream json_file(json_output_path);
+        if (!json_file.good()) {
+            throw std::runtime_error(
+                    "Unable to open file \"" + json_output_path + "\".");
+        }
+        nlohmann::json json = output.to_json();
+        json["InstancePaths"] = instance_paths;
+        json["Values"] = values;
+        json["Bounds"] = bounds;
+        json["Errors"] = errors;
+        json_file << std::setw(4) << json << std::endl;
+    }
+
+    // Same exit status as a single instance exceeding the memory limit.
+    return (memory_limit_exceeded_found)? 2: 0;
+}
+
+#ifndef _WIN32
+
+std::atomic<bool> server_stop(false);
+
+extern "C" void stop_server(int)
+{
+    server_stop = true;
+}
+
+int run_server(const po::variables_map& vm)
+{
+    ServerParameters parameters;
+    parameters.socket_path = vm["server"].as<std::string>();
+    if (vm.count("threads"))
+        parameters.number_of_threads = vm["threads"].as<int>();
+    if (vm.count("memory-limit"))
+        parameters.memory_limit = (Counter)(vm["memory-limit"].as<double>() * 1024 * 1024);
+    if (vm.count("maximum-number-of-items"))
+        parameters.maximum_number_of_items = vm["maximum-number-of-items"].as<ItemId>();
+    parameters.stop = &server_stop;
+
+    std::string algorithm = "auto";
+    if (vm.count("algorithm"))
+        algorithm = vm["algorithm"].as<std::string>();
+    if (algorithm == "auto") {
+    } else if (algorithm == "dynamic-programming-primal-dual"
+            || algorithm == "minknap") {
+        parameters.automatic_pairing = false;
+        if (vm.count("pairing"))
+            parameters.pairing = vm["pairing"].as<bool>();
+    } else {
+        parameters.algorithm = pool_algorithm(algorithm, "server", vm);
+    }
+
+    // Stop the server on SIGINT and SIGTERM.
+    std::signal(SIGINT, stop_server);
+    std::signal(SIGTERM, stop_server);
+
+    ServerOutput output = serve(parameters);
+
+    int verbosity_level = 1;
+    if (vm.count("verbosity-level"))
+        verbosity_level = vm["verbosity-level"].as<int>();
+    if (verbosity_level >= 1)
+        output.format(std::cout);
+    return 0;
+}
+
+#endif
+
 int main(int argc, char *argv[])
 {
     // Parse program options
@@ -123,13 +528,28 @@ int main(int argc, char *argv[])
     desc.add_options()
         ("help,h", "produce help message")
         ("algorithm,a", po::value<std::string>(), "set algorithm")
-        ("input,i", po::value<std::string>()->required(), "set input file (required)")
+        ("input,i", po::value<std::string>(), "set input file (required)")
+        ("batch,", po::value<std::string>(), "solve all the instances listed in a file ('-' for stdin), one path or inline JSON instance per line, with the primal-dual algorithm unless --algorithm is set; --time-limit and --memory-limit apply to each instance; the instances are read while they are solved, and the lines which can't be read or solved are reported without stopping the batch")
+        ("json-lines,", "in batch mode, write to stdout one JSON line per instance as soon as it is solved")
+        ("json-lines-solution,", "include the solutions in the JSON lines")
+        ("threads,", po::value<int>(), "set number of threads of the batch and server modes (default: 1, 0: all available)")
+#ifndef _WIN32
+        ("server,", po::value<std::string>(), "serve requests on a Unix domain socket until SIGINT or SIGTERM")
+        ("maximum-number-of-items,", po::value<ItemId>(), "in server mode, set the maximum number of items of a request (default: 10000000)")
+#endif
         ("format,f", po::value<std::string>()->default_value(""), "set input file format (default: standard)")
+        ("write-instance,", po::value<std::string>(), "write the instance to a file and exit")
+        ("write-instance-format,", po::value<std::string>()->default_value("binary"), "set format of the written instance (default: binary)")
         ("output,o", po::value<std::string>()->default_value(""), "set JSON output file")
-        ("initial-solution,", po::value<std::string>()->default_value(""), "")
+        ("initial-solution,", po::value<std::string>()->default_value(""), "set initial solution file")
+        ("lower-bound,", po::value<Profit>(), "set known lower bound")
         ("certificate,c", po::value<std::string>()->default_value(""), "set certificate file")
+        ("certificate-format,", po::value<std::string>()->default_value("standard"), "set format of the certificate and of the initial solution (standard, binary)")
         ("seed,s", po::value<Seed>()->default_value(0), "set seed")
         ("time-limit,t", po::value<double>(), "set time limit in seconds")
+        ("memory-limit,", po::value<double>(), "set memory limit in MiB")
+        ("statistics,", "collect statistics on the algorithm, written in the output")
+        ("performance-counters,", "read the hardware performance counters (Linux only), written in the statistics")
         ("verbosity-level,v", po::value<int>(), "set verbosity level")
         ("only-write-at-the-end,e", "only write output and certificate files at the end")
         ("log,l", po::value<std::string>(), "set log file")
@@ -138,6 +558,11 @@ int main(int argc, char *argv[])
         ("sort,", po::value<bool>(), "set sort")
         ("partial-solution-size,", po::value<int>(), "set partial solution size")
         ("pairing,", po::value<bool>(), "set pairing")
+        ("decision-directory,", po::value<std::string>(), "set the directory in which the Bellman array algorithm with decisions on disk creates its decision file")
+        ("checkpoint,", po::value<std::string>(), "set checkpoint file")
+        ("checkpoint-interval,", po::value<double>(), "set minimum time between two checkpoints, in seconds")
+        ("resume,", "resume from the checkpoint file if it exists")
+        ("extended,", po::value<bool>(), "set extended greedy")
         ;
     po::variables_map vm;
     po::store(po::parse_command_line(argc, argv, desc), vm);
@@ -152,6 +577,21 @@ int main(int argc, char *argv[])
         return 1;
     }
 
+    // Batch.
+    if (vm.count("batch"))
+        return run_batch(vm);
+
+#ifndef _WIN32
+    // Server.
+    if (vm.count("server"))
+        return run_server(vm);
+#endif
+
+    if (!vm.count("input")) {
+        std::cout << desc << std::endl;;
+        return 1;
+    }
+
     // Build instance.
     InstanceBuilder instance_builder;
     instance_builder.read(
@@ -159,14 +599,43 @@ int main(int argc, char *argv[])
             vm["format"].as<std::string>());
     const Instance instance = instance_builder.build();
 
+    // Convert instance.
+    if (vm.count("write-instance")) {
+        std::string instance_path = vm["write-instance"].as<std::string>();
+        std::string instance_format = vm["write-instance-format"].as<std::string>();
+        if (instance_format == "binary") {
+            instance.write_binary(instance_path);
+        } else if (instance_format == "standard" || instance_format == "") {
+            instance.write(instance_path);
+        } else {
+            throw std::invalid_argument(
+                    "Unknown instance format \"" + instance_format + "\".");
+        }
+        return 0;
+    }
+
     // Run.
-    Output output = run(instance, vm);
+    Output output(instance);
+    try {
+        output = run(instance, vm);
+    } catch (const MemoryLimitExceeded& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        std::string json_output_path = vm["output"].as<std::string>();
+        if (!json_output_path.empty()) {
+            std::ofstream file(json_output_path);
+            file << std::setw(4) << nlohmann::json {{"Error", e.to_json()}} << std::endl;
+        }
+        return 2;
+    }
 
     // Write outputs.
     std::string certificate_path = vm["certificate"].as<std::string>();
     std::string json_output_path = vm["output"].as<std::string>();
     output.write_json_output(json_output_path);
-    output.solution.write(certificate_path);
+    write_certificate(
+            output.solution,
+            certificate_path,
+            vm["certificate-format"].as<std::string>());
 
     return 0;
 }
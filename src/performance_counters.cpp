@@ -0,0 +1,189 @@
+#include "knapsacksolver/performance_counters.hpp"
+
+#include <iomanip>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cstring>
+#endif
+
+using namespace knapsacksolver;
+
+PerformanceCounterValues PerformanceCounterValues::operator-(
+        const PerformanceCounterValues& values) const
+{
+    PerformanceCounterValues difference;
+    if (cycles >= 0 && values.cycles >= 0)
+        difference.cycles = cycles - values.cycles;
+    if (instructions >= 0 && values.instructions >= 0)
+        difference.instructions = instructions - values.instructions;
+    if (cache_misses >= 0 && values.cache_misses >= 0)
+        difference.cache_misses = cache_misses - values.cache_misses;
+    if (branch_misses >= 0 && values.branch_misses >= 0)
+        difference.branch_misses = branch_misses - values.branch_misses;
+    return difference;
+}
+
+PerformanceCounterValues& PerformanceCounterValues::operator+=(
+        const PerformanceCounterValues& values)
+{
+    cycles = (cycles >= 0 && values.cycles >= 0)?
+        cycles + values.cycles: -1;
+    instructions = (instructions >= 0 && values.instructions >= 0)?
+        instructions + values.instructions: -1;
+    cache_misses = (cache_misses >= 0 && values.cache_misses >= 0)?
+        cache_misses + values.cache_misses: -1;
+    branch_misses = (branch_misses >= 0 && values.branch_misses >= 0)?
+        branch_misses + values.branch_misses: -1;
+    return *this;
+}
+
+namespace
+{
+
+nlohmann::json counter_to_json(Counter value)
+{
+    if (value < 0)
+        return nullptr;
+    return value;
+}
+
+nlohmann::json counter_per_state_to_json(
+        Counter value,
+        Counter number_of_states)
+{
+    if (value < 0)
+        return nullptr;
+    return (double)value / number_of_states;
+}
+
+}
+
+nlohmann::json PerformanceCounterValues::to_json(
+        Counter number_of_states) const
+{
+    double ipc = instructions_per_cycle();
+    nlohmann::json json {
+        {"Cycles", counter_to_json(cycles)},
+        {"Instructions", counter_to_json(instructions)},
+        {"InstructionsPerCycle", (ipc >= 0)? nlohmann::json(ipc): nlohmann::json(nullptr)},
+        {"CacheMisses", counter_to_json(cache_misses)},
+        {"BranchMisses", counter_to_json(branch_misses)}};
+    if (number_of_states > 0) {
+        json["CyclesPerState"] = counter_per_state_to_json(cycles, number_of_states);
+        json["CacheMissesPerState"] = counter_per_state_to_json(cache_misses, number_of_states);
+        json["BranchMissesPerState"] = counter_per_state_to_json(branch_misses, number_of_states);
+    }
+    return json;
+}
+
+void PerformanceCounterValues::format(
+        std::ostream& os,
+        int width,
+        const std::string& prefix,
+        Counter number_of_states) const
+{
+    if (cycles >= 0)
+        os << std::setw(width) << std::left << prefix + "Cycles: " << cycles << std::endl;
+    if (instructions >= 0)
+        os << std::setw(width) << std::left << prefix + "Instructions: " << instructions << std::endl;
+    if (instructions_per_cycle() >= 0)
+        os << std::setw(width) << std::left << prefix + "Instructions per cycle: " << instructions_per_cycle() << std::endl;
+    if (cache_misses >= 0)
+        os << std::setw(width) << std::left << prefix + "Cache misses: " << cache_misses << std::endl;
+    if (branch_misses >= 0)
+        os << std::setw(width) << std::left << prefix + "Branch misses: " << branch_misses << std::endl;
+    if (number_of_states <= 0)
+        return;
+    if (cycles >= 0)
+        os << std::setw(width) << std::left << prefix + "Cycles per state: " << (double)cycles / number_of_states << std::endl;
+    if (cache_misses >= 0)
+        os << std::setw(width) << std::left << prefix + "Cache misses per state: " << (double)cache_misses / number_of_states << std::endl;
+    if (branch_misses >= 0)
+        os << std::setw(width) << std::left << prefix + "Branch misses per state: " << (double)branch_misses / number_of_states << std::endl;
+}
+
+#ifdef __linux__
+
+namespace
+{
+
+int open_counter(uint64_t config)
+{
+    struct perf_event_attr attributes;
+    std::memset(&attributes, 0, sizeof(attributes));
+    attributes.size = sizeof(attributes);
+    attributes.type = PERF_TYPE_HARDWARE;
+    attributes.config = config;
+    attributes.exclude_kernel = 1;
+    attributes.exclude_hv = 1;
+    // Count the threads created by the parallel algorithms.
+    attributes.inherit = 1;
+    // Scale the value if the counter has been multiplexed.
+    attributes.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0);
+}
+
+Counter read_counter(int file_descriptor)
+{
+    if (file_descriptor < 0)
+        return -1;
+    uint64_t values[3];
+    if (::read(file_descriptor, values, sizeof(values)) != sizeof(values))
+        return -1;
+    if (values[2] == 0)
+        return 0;
+    if (values[2] == values[1])
+        return values[0];
+    return (Counter)((double)values[0] * values[1] / values[2]);
+}
+
+}
+
+PerformanceCounters::PerformanceCounters()
+{
+    file_descriptors_[0] = open_counter(PERF_COUNT_HW_CPU_CYCLES);
+    file_descriptors_[1] = open_counter(PERF_COUNT_HW_INSTRUCTIONS);
+    file_descriptors_[2] = open_counter(PERF_COUNT_HW_CACHE_MISSES);
+    file_descriptors_[3] = open_counter(PERF_COUNT_HW_BRANCH_MISSES);
+}
+
+PerformanceCounters::~PerformanceCounters()
+{
+    for (int file_descriptor: file_descriptors_)
+        if (file_descriptor >= 0)
+            close(file_descriptor);
+}
+
+PerformanceCounterValues PerformanceCounters::read() const
+{
+    PerformanceCounterValues values;
+    values.cycles = read_counter(file_descriptors_[0]);
+    values.instructions = read_counter(file_descriptors_[1]);
+    values.cache_misses = read_counter(file_descriptors_[2]);
+    values.branch_misses = read_counter(file_descriptors_[3]);
+    return values;
+}
+
+#else
+
+PerformanceCounters::PerformanceCounters() { }
+
+PerformanceCounters::~PerformanceCounters() { }
+
+PerformanceCounterValues PerformanceCounters::read() const
+{
+    return PerformanceCounterValues();
+}
+
+#endif
+
+bool PerformanceCounters::available() const
+{
+    for (int file_descriptor: file_descriptors_)
+        if (file_descriptor >= 0)
+            return true;
+    return false;
+}
@@ -0,0 +1,79 @@
+#include "knapsacksolver/progress_reporter.hpp"
+
+#include <chrono>
+
+using namespace knapsacksolver;
+
+constexpr unsigned ProgressReporter::new_snapshot_bit;
+
+ProgressReporter::ProgressReporter(
+        const ProgressCallback& callback,
+        double minimum_interval):
+    callback_(callback),
+    minimum_interval_(minimum_interval),
+    middle_(1),
+    number_of_overwritten_snapshots_(0),
+    number_of_reports_(0)
+{
+    thread_ = std::thread(&ProgressReporter::run, this);
+}
+
+void ProgressReporter::publish(const Output& output)
+{
+    ProgressSnapshot& snapshot = buffers_[back_];
+    snapshot.time = output.time;
+    snapshot.value = output.value;
+    snapshot.bound = output.bound;
+    snapshot.has_solution = output.has_solution();
+    unsigned middle = middle_.exchange(
+            back_ | new_snapshot_bit,
+            std::memory_order_acq_rel);
+    if (middle & new_snapshot_bit)
+        number_of_overwritten_snapshots_.fetch_add(1, std::memory_order_relaxed);
+    back_ = middle & ~new_snapshot_bit;
+}
+
+bool ProgressReporter::pop(ProgressSnapshot& snapshot)
+{
+    if (!(middle_.load(std::memory_order_relaxed) & new_snapshot_bit))
+        return false;
+    unsigned middle = middle_.exchange(front_, std::memory_order_acq_rel);
+    front_ = middle & ~new_snapshot_bit;
+    snapshot = buffers_[front_];
+    return true;
+}
+
+void ProgressReporter::run()
+{
+    auto interval = std::chrono::duration<double>(
+            (std::max)(minimum_interval_, 0.001));
+    ProgressSnapshot snapshot;
+    for (;;) {
+        bool stop = false;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            stop = condition_variable_.wait_for(
+                    lock,
+                    interval,
+                    [this]() { return stop_; });
+        }
+        if (pop(snapshot)) {
+            callback_(snapshot);
+            number_of_reports_++;
+        }
+        if (stop)
+            break;
+    }
+}
+
+void ProgressReporter::stop()
+{
+    if (!thread_.joinable())
+        return;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    condition_variable_.notify_one();
+    thread_.join();
+}
@@ -0,0 +1,514 @@
+#include "knapsacksolver/server.hpp"
+
+#include "knapsacksolver/instance_builder.hpp"
+#include "knapsacksolver/features.hpp"
+#include "knapsacksolver/algorithms/dynamic_programming_primal_dual.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <thread>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace knapsacksolver;
+
+namespace
+{
+
+#ifdef MSG_NOSIGNAL
+constexpr int send_flags = MSG_NOSIGNAL;
+#else
+constexpr int send_flags = 0;
+#endif
+
+/** Time between two checks of the stop flag while waiting, in milliseconds. */
+constexpr int poll_timeout = 100;
+
+/**
+ * Receive exactly 'size' bytes.
+ *
+ * Return 'false' if the connection has been closed or if the stop flag has
+ * been set.
+ */
+bool receive(
+        int fd,
+        void* data,
+        std::size_t size,
+        const std::atomic<bool>* stop)
+{
+    char* buffer = static_cast<char*>(data);
+    while (size > 0) {
+        if (stop != nullptr) {
+            pollfd poll_fd = {fd, POLLIN, 0};
+            int r = poll(&poll_fd, 1, poll_timeout);
+            if (stop->load())
+                return false;
+            if (r == 0 || (r < 0 && errno == EINTR))
+                continue;
+            if (r < 0)
+                return false;
+        }
+        ssize_t n = recv(fd, buffer, size, 0);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            return false;
+        buffer += n;
+        size -= n;
+    }
+    return true;
+}
+
+/**
+ * Send exactly 'size' bytes.
+ *
+ * Return 'false' if the connection has been closed.
+ */
+bool send_all(
+        int fd,
+        const void* data,
+        std::size_t size)
+{
+    const char* buffer = static_cast<const char*>(data);
+    while (size > 0) {
+        ssize_t n = send(fd, buffer, size, send_flags);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            return false;
+        buffer += n;
+        size -= n;
+    }
+    return true;
+}
+
+std::runtime_error socket_error(
+        const std::string& message,
+        const std::string& socket_path)
+{
+    return std::runtime_error(
+            message + " \"" + socket_path + "\": "
+            + std::strerror(errno) + ".");
+}
+
+sockaddr_un socket_address(const std::string& socket_path)
+{
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (socket_path.empty() || socket_path.size() >= sizeof(address.sun_path)) {
+        throw std::invalid_argument(
+                "Invalid socket path \"" + socket_path + "\".");
+    }
+    std::strcpy(address.sun_path, socket_path.c_str());
+    return address;
+}
+
+/**
+ * Memory of a thread of the server kept between requests.
+ */
+struct ServerWorker
+{
+    /** Workspace of the primal-dual dynamic programming algorithm. */
+    DynamicProgrammingPrimalDualWorkspace workspace;
+
+    /** Profits and weights of the items of the current request. */
+    std::vector<int64_t> coefficients;
+
+    /** Response. */
+    std::vector<char> response;
+};
+
+bool send_response(
+        int fd,
+        ServerWorker& worker,
+        ServerResponseType type,
+        const Output& output,
+        double time)
+{
+    const Solution& solution = output.solution;
+    ItemId number_of_items = solution.instance().number_of_items();
+    worker.response.assign(
+            sizeof(ServerResponseHeader) + (number_of_items + 7) / 8,
+            0);
+    ServerResponseHeader header;
+    std::memcpy(header.magic, server_response_magic, sizeof(header.magic));
+    header.version = server_protocol_version;
+    header.type = type;
+    header.value = output.value;
+    header.bound = output.bound;
+    header.time = time;
+    header.length = number_of_items;
+    std::memcpy(worker.response.data(), &header, sizeof(header));
+    char* bitset = worker.response.data() + sizeof(header);
+    for (ItemId item_id = 0; item_id < number_of_items; ++item_id)
+        if (solution.contains(item_id))
+            bitset[item_id / 8] |= (char)(1 << (item_id % 8));
+    return send_all(fd, worker.response.data(), worker.response.size());
+}
+
+bool send_error(
+        int fd,
+        const std::string& message)
+{
+    ServerResponseHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, server_response_magic, sizeof(header.magic));
+    header.version = server_protocol_version;
+    header.type = ServerResponseType::Error;
+    header.length = message.size();
+    return send_all(fd, &header, sizeof(header))
+        && send_all(fd, message.data(), message.size());
+}
+
+/**
+ * Solve the instance of a request and send the responses.
+ *
+ * Return 'false' if the connection has been closed.
+ */
+bool solve_request(
+        int fd,
+        ServerWorker& worker,
+        const ServerRequestHeader& request_header,
+        const Instance& instance,
+        const ServerParameters& server_parameters)
+{
+    bool connection_open = true;
+    // The callback is also called when only the value or the bound improves.
+    // A new solution is always strictly better than the previous one, except
+    // for the first one.
+    bool solution_sent = false;
+    Profit solution_sent_value = 0;
+    auto new_solution_callback = [
+        fd,
+        &worker,
+        &connection_open,
+        &solution_sent,
+        &solution_sent_value](
+                const Output& output,
+                double time)
+    {
+        if (!connection_open || !output.solution.feasible())
+            return;
+        if (solution_sent
+                && output.solution.objective_value() <= solution_sent_value) {
+            return;
+        }
+        solution_sent = true;
+        solution_sent_value = output.solution.objective_value();
+        connection_open = send_response(
+                fd,
+                worker,
+                ServerResponseType::Solution,
+                output,
+                time);
+    };
+
+    auto set_parameters = [
+        &request_header,
+        &server_parameters,
+        &new_solution_callback](
+                Parameters& parameters)
+    {
+        parameters.verbosity_level = 0;
+        parameters.memory_limit = server_parameters.memory_limit;
+        if (request_header.time_limit > 0)
+            parameters.timer.set_time_limit(request_header.time_limit);
+        parameters.stop = server_parameters.stop;
+        if (request_header.flags & server_request_flag_new_solutions) {
+            parameters.new_solution_callback = [
+                &new_solution_callback,
+                &parameters](
+                        const Output& output)
+            {
+                new_solution_callback(output, parameters.timer.elapsed_time());
+            };
+        }
+    };
+
+    if (server_parameters.algorithm) {
+        Parameters parameters;
+        set_parameters(parameters);
+        Output output = server_parameters.algorithm(instance, parameters);
+        return connection_open && send_response(
+                fd,
+                worker,
+                ServerResponseType::Final,
+                output,
+                parameters.timer.elapsed_time());
+    }
+
+    DynamicProgrammingPrimalDualParameters parameters;
+    set_parameters(parameters);
+    parameters.workspace = &worker.workspace;
+    if (server_parameters.automatic_pairing) {
+        parameters.pairing = select_algorithm(compute_features(instance)).pairing;
+    } else {
+        parameters.pairing = server_parameters.pairing;
+    }
+    auto output = dynamic_programming_primal_dual(instance, parameters);
+    return connection_open && send_response(
+            fd,
+            worker,
+            ServerResponseType::Final,
+            output,
+            parameters.timer.elapsed_time());
+}
+
+/**
+ * Get the maximum number of items of a request.
+ *
+ * The memory of a request is the coefficients received and the items of the
+ * instance builder and of the instance.
+ */
+ItemId maximum_number_of_items(
+        const ServerParameters& parameters)
+{
+    ItemId number_of_items = parameters.maximum_number_of_items;
+    if (parameters.memory_limit >= 0) {
+        Counter item_memory = 2 * sizeof(int64_t) + 2 * sizeof(Item);
+        number_of_items = (std::min)(
+                number_of_items,
+                (ItemId)(parameters.memory_limit / item_memory));
+    }
+    return number_of_items;
+}
+
+/**
+ * Serve the requests of a connection until it is closed.
+ */
+void serve_connection(
+        int fd,
+        ServerWorker& worker,
+        const ServerParameters& parameters,
+        std::atomic<Counter>& number_of_requests)
+{
+    for (;;) {
+        ServerRequestHeader header;
+        if (!receive(fd, &header, sizeof(header), parameters.stop))
+            return;
+        if (std::memcmp(header.magic, server_request_magic, sizeof(header.magic)) != 0
+                || header.version != server_protocol_version) {
+            send_error(fd, "Invalid request header.");
+            return;
+        }
+        if (header.number_of_items < 0
+                || header.number_of_items > (int64_t)(std::numeric_limits<ItemId>::max() / 2)) {
+            send_error(fd, "Invalid number of items.");
+            return;
+        }
+        if (header.number_of_items > (int64_t)maximum_number_of_items(parameters)) {
+            send_error(
+                    fd,
+                    "Too many items: " + std::to_string(header.number_of_items)
+                    + " > " + std::to_string(maximum_number_of_items(parameters)) + ".");
+            return;
+        }
+
+        // Until the coefficients have been received, the connection can't be
+        // used for the following requests.
+        bool coefficients_received = false;
+        try {
+            worker.coefficients.resize(2 * header.number_of_items);
+            if (!receive(
+                        fd,
+                        worker.coefficients.data(),
+                        worker.coefficients.size() * sizeof(int64_t),
+                        parameters.stop)) {
+                return;
+            }
+            coefficients_received = true;
+
+            InstanceBuilder instance_builder;
+            instance_builder.set_capacity(header.capacity);
+            for (ItemId item_id = 0;
+                    item_id < header.number_of_items;
+                    ++item_id) {
+                instance_builder.add_item(
+                        worker.coefficients[item_id],
+                        worker.coefficients[header.number_of_items + item_id]);
+            }
+            const Instance instance = instance_builder.build();
+            bool connection_open = solve_request(
+                    fd,
+                    worker,
+                    header,
+                    instance,
+                    parameters);
+            number_of_requests++;
+            if (!connection_open)
+                return;
+        } catch (const std::exception& e) {
+            number_of_requests++;
+            if (!send_error(fd, e.what()) || !coefficients_received)
+                return;
+        }
+    }
+}
+
+}
+
+ServerOutput knapsacksolver::serve(
+        const ServerParameters& parameters)
+{
+    sockaddr_un address = socket_address(parameters.socket_path);
+    int listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listen_fd < 0)
+        throw socket_error("Unable to create socket", parameters.socket_path);
+    unlink(parameters.socket_path.c_str());
+    if (bind(listen_fd, (sockaddr*)&address, sizeof(address)) != 0
+            || listen(listen_fd, SOMAXCONN) != 0) {
+        std::runtime_error error = socket_error(
+                "Unable to listen on socket",
+                parameters.socket_path);
+        close(listen_fd);
+        throw error;
+    }
+    // The threads wait for connections with 'poll', so that they can check
+    // the stop flag, and they race to accept them.
+    fcntl(listen_fd, F_SETFL, fcntl(listen_fd, F_GETFL) | O_NONBLOCK);
+
+    std::atomic<Counter> number_of_connections(0);
+    std::atomic<Counter> number_of_requests(0);
+    auto worker_function = [
+        listen_fd,
+        &parameters,
+        &number_of_connections,
+        &number_of_requests]()
+    {
+        ServerWorker worker;
+        while (parameters.stop == nullptr || !parameters.stop->load()) {
+            pollfd poll_fd = {listen_fd, POLLIN, 0};
+            if (poll(&poll_fd, 1, poll_timeout) <= 0)
+                continue;
+            int fd = accept(listen_fd, nullptr, nullptr);
+            if (fd < 0)
+                continue;
+            // The accepted socket may inherit the non-blocking flag.
+            fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) & ~O_NONBLOCK);
+#ifdef SO_NOSIGPIPE
+            int one = 1;
+            setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+#endif
+            number_of_connections++;
+            serve_connection(fd, worker, parameters, number_of_requests);
+            close(fd);
+        }
+    };
+
+    std::size_t number_of_threads = parameters.number_of_threads;
+    if (number_of_threads == 0)
+        number_of_threads = (std::max)(1u, std::thread::hardware_concurrency());
+    std::vector<std::thread> threads;
+    for (std::size_t thread_id = 1; thread_id < number_of_threads; ++thread_id)
+        threads.push_back(std::thread(worker_function));
+    worker_function();
+    for (std::thread& thread: threads)
+        thread.join();
+
+    close(listen_fd);
+    unlink(parameters.socket_path.c_str());
+
+    ServerOutput output;
+    output.number_of_connections = number_of_connections;
+    output.number_of_requests = number_of_requests;
+    return output;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+///////////////////////////////// ServerClient /////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+ServerClient::ServerClient(
+        const std::string& socket_path)
+{
+    sockaddr_un address = socket_address(socket_path);
+    socket_fd_ = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (socket_fd_ < 0)
+        throw socket_error("Unable to create socket", socket_path);
+    if (connect(socket_fd_, (sockaddr*)&address, sizeof(address)) != 0) {
+        std::runtime_error error = socket_error(
+                "Unable to connect to socket",
+                socket_path);
+        close(socket_fd_);
+        throw error;
+    }
+#ifdef SO_NOSIGPIPE
+    int one = 1;
+    setsockopt(socket_fd_, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+#endif
+}
+
+ServerClient::~ServerClient()
+{
+    close(socket_fd_);
+}
+
+ServerResponse ServerClient::solve(
+        const Instance& instance,
+        double time_limit,
+        const std::function<void(const ServerResponse&)>& new_solution_callback)
+{
+    // Send request.
+    ItemId number_of_items = instance.number_of_items();
+    ServerRequestHeader request_header;
+    std::memcpy(request_header.magic, server_request_magic, sizeof(request_header.magic));
+    request_header.version = server_protocol_version;
+    request_header.flags = (new_solution_callback)?
+        server_request_flag_new_solutions: 0;
+    request_header.number_of_items = number_of_items;
+    request_header.capacity = instance.capacity();
+    request_header.time_limit = time_limit;
+    std::vector<int64_t> coefficients(2 * number_of_items);
+    for (ItemId item_id = 0; item_id < number_of_items; ++item_id) {
+        coefficients[item_id] = instance.item(item_id).profit;
+        coefficients[number_of_items + item_id] = instance.item(item_id).weight;
+    }
+    if (!send_all(socket_fd_, &request_header, sizeof(request_header))
+            || !send_all(
+                socket_fd_,
+                coefficients.data(),
+                coefficients.size() * sizeof(int64_t))) {
+        throw std::runtime_error("Connection to the server closed.");
+    }
+
+    // Receive responses.
+    std::vector<char> payload;
+    for (;;) {
+        ServerResponseHeader header;
+        if (!receive(socket_fd_, &header, sizeof(header), nullptr))
+            throw std::runtime_error("Connection to the server closed.");
+        if (std::memcmp(header.magic, server_response_magic, sizeof(header.magic)) != 0
+                || header.version != server_protocol_version) {
+            throw std::runtime_error("Invalid response header.");
+        }
+        if (header.type == ServerResponseType::Error) {
+            payload.resize(header.length);
+            if (!receive(socket_fd_, payload.data(), payload.size(), nullptr))
+                throw std::runtime_error("Connection to the server closed.");
+            throw std::runtime_error(
+                    "Server error: " + std::string(payload.begin(), payload.end()));
+        }
+        if (header.length != number_of_items)
+            throw std::runtime_error("Invalid response length.");
+        payload.resize((number_of_items + 7) / 8);
+        if (!receive(socket_fd_, payload.data(), payload.size(), nullptr))
+            throw std::runtime_error("Connection to the server closed.");
+
+        ServerResponse response(instance);
+        for (ItemId item_id = 0; item_id < number_of_items; ++item_id)
+            if (payload[item_id / 8] & (1 << (item_id % 8)))
+                response.solution.add(item_id);
+        response.value = header.value;
+        response.bound = header.bound;
+        response.time = header.time;
+        if (header.type == ServerResponseType::Final)
+            return response;
+        if (new_solution_callback)
+            new_solution_callback(response);
+    }
+}
@@ -2,9 +2,52 @@
 
 using namespace knapsacksolver;
 
+namespace
+{
+
+/** Get the number of bits set in a word. */
+inline int popcount(uint64_t word)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(word);
+#else
+    word = word - ((word >> 1) & 0x5555555555555555ULL);
+    word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+    word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return (int)((word * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+/** Get the position of the lowest bit set in a non-zero word. */
+inline int count_trailing_zeros(uint64_t word)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(word);
+#else
+    return popcount((word & (~word + 1)) - 1);
+#endif
+}
+
+/** Call 'function' for each item of a bitset, in increasing order. */
+template <typename Function>
+void for_each_item(
+        const std::vector<uint64_t>& words,
+        Function function)
+{
+    for (std::size_t word_pos = 0; word_pos < words.size(); ++word_pos) {
+        uint64_t word = words[word_pos];
+        while (word != 0) {
+            function((ItemId)(64 * word_pos + count_trailing_zeros(word)));
+            word &= word - 1;
+        }
+    }
+}
+
+}
+
 Solution::Solution(const Instance& instance):
     instance_(&instance),
-    contains_(instance.number_of_items(), 0)
+    words_((instance.number_of_items() + 63) / 64, 0)
 { }
 
 Solution::Solution(
@@ -15,7 +58,7 @@ Solution::Solution(
 {
     if (certificate_path.empty())
         return;
-    std::ifstream file(certificate_path);
+    std::ifstream file(certificate_path, std::ios::binary);
     if (!file.good()) {
         throw std::runtime_error(
                 "Unable to open file \"" + certificate_path + "\".");
@@ -42,6 +85,48 @@ Solution::Solution(
             if (contains)
                 add(item_id);
         }
+    } else if (certificate_format == "binary") {
+        SolutionBinaryHeader header;
+        file.read(reinterpret_cast<char*>(&header), sizeof(header));
+        if (!file.good()
+                || !std::equal(
+                    solution_binary_magic,
+                    solution_binary_magic + sizeof(header.magic),
+                    header.magic)) {
+            throw std::invalid_argument(
+                    "File \"" + certificate_path + "\" is not a binary certificate file.");
+        }
+        if (header.version != solution_binary_version) {
+            throw std::invalid_argument(
+                    "Unsupported binary certificate version "
+                    + std::to_string(header.version) + ".");
+        }
+        if (header.number_of_items != instance.number_of_items()) {
+            throw std::invalid_argument(
+                    "The certificate \"" + certificate_path
+                    + "\" doesn't match the number of items of the instance.");
+        }
+        file.read(
+                reinterpret_cast<char*>(words_.data()),
+                words_.size() * sizeof(uint64_t));
+        if (!file.good()) {
+            throw std::invalid_argument(
+                    "File \"" + certificate_path + "\" is truncated.");
+        }
+        // Clear the bits after the last item.
+        if (instance.number_of_items() % 64 != 0)
+            words_.back() &= ((uint64_t)1 << (instance.number_of_items() % 64)) - 1;
+        for (uint64_t word: words_)
+            number_of_items_ += popcount(word);
+        if (number_of_items_ != header.number_of_items_in_solution) {
+            throw std::invalid_argument(
+                    "The certificate \"" + certificate_path + "\" is corrupted.");
+        }
+        for_each_item(words_, [this, &instance](ItemId item_id)
+        {
+            weight_ += instance.item(item_id).weight;
+            profit_ += instance.item(item_id).profit;
+        });
     } else {
         throw std::invalid_argument(
                 "Unknown certificate format \"" + certificate_format + "\".");
@@ -50,7 +135,7 @@ Solution::Solution(
 
 void Solution::add(ItemId item_id)
 {
-    contains_[item_id] = 1;
+    words_[item_id >> 6] |= (uint64_t)1 << (item_id & 63);
     number_of_items_++;
     weight_ += instance().item(item_id).weight;
     profit_ += instance().item(item_id).profit;
@@ -58,7 +143,7 @@ void Solution::add(ItemId item_id)
 
 void Solution::remove(ItemId item_id)
 {
-    contains_[item_id] = 0;
+    words_[item_id >> 6] &= ~((uint64_t)1 << (item_id & 63));
     number_of_items_--;
     weight_ -= instance().item(item_id).weight;
     profit_ -= instance().item(item_id).profit;
@@ -66,11 +151,20 @@ void Solution::remove(ItemId item_id)
 
 void Solution::fill()
 {
-    for (ItemId item_id = 0;
-            item_id < instance().number_of_items();
-            ++item_id) {
-        add(item_id);
-    }
+    std::fill(words_.begin(), words_.end(), ~(uint64_t)0);
+    if (instance().number_of_items() % 64 != 0)
+        words_.back() = ((uint64_t)1 << (instance().number_of_items() % 64)) - 1;
+    number_of_items_ = instance().number_of_items();
+    weight_ = instance().total_item_weight();
+    profit_ = instance().total_item_profit();
+}
+
+ItemPos Solution::distance(const Solution& solution) const
+{
+    ItemPos distance = 0;
+    for (std::size_t word_pos = 0; word_pos < words_.size(); ++word_pos)
+        distance += popcount(words_[word_pos] ^ solution.words_[word_pos]);
+    return distance;
 }
 
 void Solution::write(std::string certificate_path) const
@@ -83,10 +177,41 @@ void Solution::write(std::string certificate_path) const
                 "Unable to open file \"" + certificate_path + "\".");
     }
 
-    file << number_of_items() << std::endl;
-    for (ItemId item_id = 0; item_id < instance().number_of_items(); ++item_id)
-        if (contains(item_id))
-            file << item_id << std::endl;
+    file << number_of_items() << "\n";
+    for_each_item(words_, [&file](ItemId item_id)
+    {
+        file << item_id << "\n";
+    });
+}
+
+void Solution::write_binary(std::string certificate_path) const
+{
+    if (certificate_path.empty())
+        return;
+    std::ofstream file(certificate_path, std::ios::binary);
+    if (!file.good()) {
+        throw std::runtime_error(
+                "Unable to open file \"" + certificate_path + "\".");
+    }
+
+    SolutionBinaryHeader header;
+    std::copy(
+            solution_binary_magic,
+            solution_binary_magic + sizeof(header.magic),
+            header.magic);
+    header.version = solution_binary_version;
+    header.padding = 0;
+    header.number_of_items = instance().number_of_items();
+    header.number_of_items_in_solution = number_of_items();
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(
+            reinterpret_cast<const char*>(words_.data()),
+            words_.size() * sizeof(uint64_t));
+
+    if (!file.good()) {
+        throw std::runtime_error(
+                "Unable to write file \"" + certificate_path + "\".");
+    }
 }
 
 void Solution::format(
@@ -108,15 +233,12 @@ void Solution::format(
             << std::endl
             << std::setw(12) << "----"
             << std::endl;
-        for (ItemId item_id = 0;
-                item_id < instance().number_of_items();
-                ++item_id) {
-            if (!contains(item_id))
-                continue;
+        for_each_item(words_, [&os](ItemId item_id)
+        {
             os
                 << std::setw(12) << item_id
                 << std::endl;
-        }
+        });
     }
 }
 
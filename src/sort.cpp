@@ -1,6 +1,7 @@
 #include "knapsacksolver/sort.hpp"
 
 #include "knapsacksolver/upper_bound.hpp"
+#include "knapsacksolver/checkpoint.hpp"
 
 using namespace knapsacksolver;
 
@@ -376,6 +377,39 @@ void PartialSort::move_item_to_core(
     }
 }
 
+void PartialSort::write_checkpoint(
+        CheckpointWriter& writer) const
+{
+    writer.write(sorted_items_);
+    writer.write(intervals_left_);
+    writer.write(intervals_right_);
+    writer.write(first_sorted_item_pos_);
+    writer.write(last_sorted_item_pos_);
+    writer.write(initial_core_first_item_pos_);
+    writer.write(initial_core_last_item_pos_);
+    writer.write(mandatory_items_);
+}
+
+void PartialSort::read_checkpoint(
+        CheckpointReader& reader)
+{
+    // The break solution only depends on the initial partition, which is
+    // deterministic, so it is not stored.
+    reader.read(sorted_items_, instance().number_of_items());
+    reader.read(intervals_left_, instance().number_of_items());
+    reader.read(intervals_right_, instance().number_of_items());
+    reader.read(first_sorted_item_pos_);
+    reader.read(last_sorted_item_pos_);
+    reader.read(initial_core_first_item_pos_);
+    reader.read(initial_core_last_item_pos_);
+    mandatory_items_ = Solution(instance());
+    reader.read(mandatory_items_);
+    if ((ItemPos)sorted_items_.size() != instance().number_of_items()) {
+        throw std::invalid_argument(
+                "The checkpoint doesn't match the partial sort.");
+    }
+}
+
 bool PartialSort::check() const
 {
     if (break_item_id() < 0) {
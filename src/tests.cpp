@@ -122,3 +122,13 @@ const Solution knapsacksolver::get_solution(
             certificate_path,
             files.certificate_format);
 }
+
+const Instance knapsacksolver::build_test_instance(
+        ItemId number_of_items)
+{
+    InstanceBuilder instance_builder;
+    instance_builder.set_capacity(number_of_items * 10);
+    for (ItemId item_id = 0; item_id < number_of_items; ++item_id)
+        instance_builder.add_item(item_id + 1, item_id % 7 + 1);
+    return instance_builder.build();
+}
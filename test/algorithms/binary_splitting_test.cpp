@@ -0,0 +1,162 @@
+#include "knapsacksolver/tests.hpp"
+
+#include "knapsacksolver/algorithms/binary_splitting.hpp"
+#include "knapsacksolver/algorithms/dynamic_programming_bellman.hpp"
+
+#include "knapsacksolver/instance_builder.hpp"
+
+#include <random>
+
+using namespace knapsacksolver;
+
+TEST(BinarySplitting, BinarySplitting)
+{
+    std::mt19937_64 generator(0);
+    std::uniform_int_distribution<Weight> distribution_weight(1, 100);
+    std::uniform_int_distribution<ItemId> distribution_copies(0, 20);
+    for (Counter instance_id = 0; instance_id < 100; ++instance_id) {
+
+        // Generate a bounded instance and the equivalent 0-1 instance
+        // containing one item per copy.
+        BoundedInstanceBuilder bounded_instance_builder;
+        InstanceBuilder instance_builder;
+        Weight capacity = 10 * distribution_weight(generator);
+        bounded_instance_builder.set_capacity(capacity);
+        instance_builder.set_capacity(capacity);
+        ItemId number_of_items = 1 + distribution_copies(generator);
+        for (ItemId item_id = 0; item_id < number_of_items; ++item_id) {
+            Profit profit = distribution_weight(generator);
+            Weight weight = distribution_weight(generator);
+            ItemId number_of_copies = distribution_copies(generator);
+            bounded_instance_builder.add_item(profit, weight, number_of_copies);
+            if (weight > capacity)
+                continue;
+            for (ItemId copy = 0; copy < number_of_copies; ++copy)
+                instance_builder.add_item(profit, weight);
+        }
+        const BoundedInstance bounded_instance = bounded_instance_builder.build();
+        const Instance instance = instance_builder.build();
+
+        Parameters parameters;
+        parameters.verbosity_level = 0;
+        auto output = dynamic_programming_bellman_array(instance, parameters);
+
+        BinarySplittingParameters binary_splitting_parameters;
+        binary_splitting_parameters.verbosity_level = 0;
+        auto binary_splitting_output = binary_splitting(
+                bounded_instance,
+                binary_splitting_parameters);
+
+        // Check the number of copies.
+        Profit profit = 0;
+        Weight weight = 0;
+        for (ItemId item_id = 0;
+                item_id < bounded_instance.number_of_items();
+                ++item_id) {
+            const BoundedItem& item = bounded_instance.item(item_id);
+            ItemId number_of_copies = binary_splitting_output.number_of_copies[item_id];
+            EXPECT_GE(number_of_copies, 0);
+            EXPECT_LE(number_of_copies, item.number_of_copies);
+            profit += number_of_copies * item.profit;
+            weight += number_of_copies * item.weight;
+        }
+        EXPECT_EQ(binary_splitting_output.value, output.value);
+        EXPECT_EQ(binary_splitting_output.bound, output.value);
+        EXPECT_EQ(profit, output.value);
+        EXPECT_EQ(weight, binary_splitting_output.weight);
+        EXPECT_LE(weight, capacity);
+    }
+}
+
+TEST(BinarySplitting, OptimalLowerBound)
+{
+    BoundedInstanceBuilder bounded_instance_builder;
+    bounded_instance_builder.set_capacity(10);
+    bounded_instance_builder.add_item(7, 6, 2);
+    bounded_instance_builder.add_item(5, 5, 3);
+    const BoundedInstance bounded_instance = bounded_instance_builder.build();
+
+    BinarySplittingParameters parameters;
+    parameters.verbosity_level = 0;
+    auto output = binary_splitting(bounded_instance, parameters);
+    EXPECT_EQ(output.value, 10);
+
+    // The lower bound is optimal, so the copies retrieved might not reach it,
+    // but they must be consistent with the value.
+    parameters.lower_bound = output.value;
+    output = binary_splitting(bounded_instance, parameters);
+    Profit profit = 0;
+    Weight weight = 0;
+    for (ItemId item_id = 0;
+            item_id < bounded_instance.number_of_items();
+            ++item_id) {
+        const BoundedItem& item = bounded_instance.item(item_id);
+        profit += output.number_of_copies[item_id] * item.profit;
+        weight += output.number_of_copies[item_id] * item.weight;
+    }
+    EXPECT_EQ(output.value, profit);
+    EXPECT_EQ(output.weight, weight);
+    EXPECT_LE(output.value, 10);
+    EXPECT_EQ(output.bound, 10);
+}
+
+TEST(BinarySplitting, MemoryLimit)
+{
+    BoundedInstanceBuilder bounded_instance_builder;
+    bounded_instance_builder.set_capacity(1000);
+    bounded_instance_builder.add_item(7, 6, 100);
+    bounded_instance_builder.add_item(5, 5, 100);
+    const BoundedInstance bounded_instance = bounded_instance_builder.build();
+
+    // The 0-1 knapsack instance doesn't fit.
+    BinarySplittingParameters parameters;
+    parameters.verbosity_level = 0;
+    parameters.memory_limit = 16;
+    EXPECT_THROW(
+            binary_splitting(bounded_instance, parameters),
+            MemoryLimitExceeded);
+
+    // The limit is given to the algorithm solving the 0-1 knapsack instance.
+    parameters.memory_limit = 1024 * 1024;
+    parameters.algorithm = [](
+            const Instance& instance,
+            const Parameters& parameters)
+    {
+        EXPECT_EQ(parameters.memory_limit, 1024 * 1024);
+        return Output(instance);
+    };
+    binary_splitting(bounded_instance, parameters);
+}
+
+TEST(BinarySplitting, Statistics)
+{
+    BoundedInstanceBuilder bounded_instance_builder;
+    bounded_instance_builder.set_capacity(1000);
+    bounded_instance_builder.add_item(7, 6, 100);
+    bounded_instance_builder.add_item(5, 5, 100);
+    bounded_instance_builder.add_item(11, 9, 100);
+    const BoundedInstance bounded_instance = bounded_instance_builder.build();
+
+    // The statistics of the algorithm solving the 0-1 knapsack instance are
+    // returned.
+    BinarySplittingParameters parameters;
+    parameters.verbosity_level = 0;
+    parameters.statistics = true;
+    auto output = binary_splitting(bounded_instance, parameters);
+    EXPECT_TRUE(output.statistics.enabled);
+    EXPECT_GT(output.statistics.number_of_states_processed, 0);
+    EXPECT_TRUE(output.to_json().count("Statistics"));
+
+    // The other parameters are given to the algorithm as well.
+    parameters.performance_counters = true;
+    parameters.algorithm = [](
+            const Instance& instance,
+            const Parameters& parameters)
+    {
+        EXPECT_TRUE(parameters.statistics);
+        EXPECT_TRUE(parameters.performance_counters);
+        EXPECT_EQ(parameters.verbosity_level, 0);
+        return Output(instance);
+    };
+    binary_splitting(bounded_instance, parameters);
+}
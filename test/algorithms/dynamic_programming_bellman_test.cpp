@@ -2,6 +2,12 @@
 
 #include "knapsacksolver/algorithms/dynamic_programming_bellman.hpp"
 
+#include "knapsacksolver/instance_builder.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+
 using namespace knapsacksolver;
 
 TEST_P(ExactAlgorithmTest, ExactAlgorithm)
@@ -82,6 +88,10 @@ INSTANTIATE_TEST_SUITE_P(
                         return dynamic_programming_bellman_array_all(instance);
                     },
                     [](const Instance& instance)
+                    {
+                        return dynamic_programming_bellman_array_disk(instance);
+                    },
+                    [](const Instance& instance)
                     {
                         return dynamic_programming_bellman_array_one(instance);
                     },
@@ -111,7 +121,313 @@ INSTANTIATE_TEST_SUITE_P(
                     {
                         return dynamic_programming_bellman_array_rec(instance);
                     },
+                    [](const Instance& instance)
+                    {
+                        // Falls back to the table of decisions.
+                        Parameters parameters;
+                        parameters.memory_limit = (instance.capacity() + 1) * sizeof(Profit)
+                            + instance.number_of_items() * (instance.capacity() + 1) / 8 + 1;
+                        return dynamic_programming_bellman_array_all(instance, parameters);
+                    },
+                    [](const Instance& instance)
+                    {
+                        // Falls back to the recursive scheme if the table of
+                        // decisions doesn't fit either.
+                        Parameters parameters;
+                        parameters.memory_limit = 2 * (instance.capacity() + 1) * sizeof(Profit);
+                        return dynamic_programming_bellman_rec(instance, parameters);
+                    },
                 },
                 {
                     get_test_instance_paths(),
                 })));
+
+class DynamicProgrammingBellmanArrayCapacitiesTest: public testing::TestWithParam<TestInstancePath> { };
+
+TEST_P(DynamicProgrammingBellmanArrayCapacitiesTest, DynamicProgrammingBellmanArrayCapacities)
+{
+    TestInstancePath files = GetParam();
+    const Instance instance = get_instance(files);
+    const Solution solution = get_solution(instance, files);
+
+    DynamicProgrammingBellmanArrayCapacitiesParameters parameters;
+    parameters.verbosity_level = 0;
+    parameters.solutions = true;
+    Weight step = std::max((Weight)1, instance.capacity() / 16);
+    for (Weight capacity = 0; capacity < instance.capacity(); capacity += step)
+        parameters.capacities.push_back(capacity);
+    parameters.capacities.push_back(instance.capacity());
+    auto output = dynamic_programming_bellman_array_capacities(instance, parameters);
+    EXPECT_EQ(output.value, solution.profit());
+    EXPECT_EQ(output.bound, solution.profit());
+
+    for (std::size_t pos = 0; pos < parameters.capacities.size(); ++pos) {
+        Weight capacity = parameters.capacities[pos];
+
+        // Solve the instance with the current capacity.
+        InstanceBuilder instance_builder;
+        instance_builder.set_capacity(capacity);
+        for (ItemId item_id = 0;
+                item_id < instance.number_of_items();
+                ++item_id) {
+            const Item& item = instance.item(item_id);
+            if (item.weight <= capacity)
+                instance_builder.add_item(item.profit, item.weight);
+        }
+        const Instance instance_capacity = instance_builder.build();
+        Parameters parameters_capacity;
+        parameters_capacity.verbosity_level = 0;
+        auto output_capacity = dynamic_programming_bellman_array(
+                instance_capacity,
+                parameters_capacity);
+
+        EXPECT_EQ(output.values[pos], output_capacity.value);
+        EXPECT_EQ(output.solutions[pos].profit(), output.values[pos]);
+        EXPECT_LE(output.solutions[pos].weight(), capacity);
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+        KnapsackDynamicProgrammingBellmanArrayCapacities,
+        DynamicProgrammingBellmanArrayCapacitiesTest,
+        testing::ValuesIn(get_test_instance_paths()));
+
+TEST(DynamicProgrammingBellmanArrayCapacities, Interrupted)
+{
+    InstanceBuilder instance_builder;
+    instance_builder.set_capacity(10);
+    instance_builder.add_item(7, 6);
+    instance_builder.add_item(5, 5);
+    instance_builder.add_item(5, 5);
+    const Instance instance = instance_builder.build();
+
+    // The values and the solutions are filled even if no item is processed.
+    std::atomic<bool> stop(true);
+    DynamicProgrammingBellmanArrayCapacitiesParameters parameters;
+    parameters.verbosity_level = 0;
+    parameters.stop = &stop;
+    parameters.capacities = {0, 5, 10};
+    parameters.solutions = true;
+    auto output = dynamic_programming_bellman_array_capacities(instance, parameters);
+    ASSERT_EQ(output.values.size(), 3u);
+    ASSERT_EQ(output.solutions.size(), 3u);
+    for (std::size_t pos = 0; pos < parameters.capacities.size(); ++pos) {
+        EXPECT_EQ(output.values[pos], 0);
+        EXPECT_EQ(output.solutions[pos].number_of_items(), 0);
+    }
+    EXPECT_EQ(output.bound, instance.total_item_profit());
+
+    parameters.capacities = {-1};
+    EXPECT_THROW(
+            dynamic_programming_bellman_array_capacities(instance, parameters),
+            std::invalid_argument);
+}
+
+class DynamicProgrammingBellmanStopTest: public testing::TestWithParam<TestInstancePath> { };
+
+TEST_P(DynamicProgrammingBellmanStopTest, DynamicProgrammingBellmanStop)
+{
+    TestInstancePath files = GetParam();
+    const Instance instance = get_instance(files);
+    if (instance.number_of_items() == 0)
+        return;
+
+    // The algorithms must stop before processing any item.
+    std::atomic<bool> stop(true);
+    Parameters parameters;
+    parameters.verbosity_level = 0;
+    parameters.stop = &stop;
+    auto output_array = dynamic_programming_bellman_array(instance, parameters);
+    EXPECT_EQ(output_array.value, 0);
+    EXPECT_EQ(output_array.bound, instance.total_item_profit());
+    auto output_rec = dynamic_programming_bellman_rec(instance, parameters);
+    EXPECT_EQ(output_rec.value, 0);
+    EXPECT_EQ(output_rec.bound, instance.total_item_profit());
+
+    // Once the flag is reset, the algorithms solve the instance.
+    stop = false;
+    const Solution solution = get_solution(instance, files);
+    output_array = dynamic_programming_bellman_array(instance, parameters);
+    EXPECT_EQ(output_array.value, solution.profit());
+}
+
+INSTANTIATE_TEST_SUITE_P(
+        KnapsackDynamicProgrammingBellmanStop,
+        DynamicProgrammingBellmanStopTest,
+        testing::ValuesIn(get_test_instance_paths()));
+
+TEST(DynamicProgrammingBellmanArrayDisk, DecisionDirectory)
+{
+    InstanceBuilder instance_builder;
+    instance_builder.set_capacity(10);
+    instance_builder.add_item(7, 6);
+    instance_builder.add_item(5, 5);
+    instance_builder.add_item(5, 5);
+    const Instance instance = instance_builder.build();
+
+    boost::filesystem::path directory
+        = boost::filesystem::temp_directory_path()
+        / boost::filesystem::unique_path();
+    boost::filesystem::create_directory(directory);
+    boost::filesystem::path existing_path = directory / "decisions.bin";
+    {
+        std::ofstream existing_file(existing_path.string());
+        existing_file << "data";
+    }
+
+    // The decision file is created next to the existing file, which is left
+    // untouched, and nothing remains in the directory at the end.
+    DynamicProgrammingBellmanArrayDiskParameters parameters;
+    parameters.verbosity_level = 0;
+    parameters.decision_directory = directory.string();
+    auto output = dynamic_programming_bellman_array_disk(instance, parameters);
+    EXPECT_EQ(output.value, 10);
+    std::vector<boost::filesystem::path> paths{
+        boost::filesystem::directory_iterator(directory),
+        boost::filesystem::directory_iterator()};
+    ASSERT_EQ(paths.size(), 1u);
+    EXPECT_EQ(paths[0], existing_path);
+    EXPECT_EQ(boost::filesystem::file_size(existing_path), 4u);
+
+    parameters.decision_directory = (directory / "missing").string();
+    EXPECT_THROW(
+            dynamic_programming_bellman_array_disk(instance, parameters),
+            std::runtime_error);
+    boost::filesystem::remove_all(directory);
+}
+
+class DynamicProgrammingBellmanArrayOneCheckpointTest: public testing::TestWithParam<TestInstancePath> { };
+
+TEST_P(DynamicProgrammingBellmanArrayOneCheckpointTest, DynamicProgrammingBellmanArrayOneCheckpoint)
+{
+    TestInstancePath files = GetParam();
+    const Instance instance = get_instance(files);
+    const Solution solution = get_solution(instance, files);
+    std::string checkpoint_path = "dynamic_programming_bellman_array_one_test.checkpoint";
+    std::remove(checkpoint_path.c_str());
+
+    // Interrupted before processing any item.
+    {
+        std::atomic<bool> stop(true);
+        DynamicProgrammingBellmanArrayOneParameters parameters;
+        parameters.verbosity_level = 0;
+        parameters.stop = &stop;
+        parameters.checkpoint_path = checkpoint_path;
+        dynamic_programming_bellman_array_one(instance, parameters);
+    }
+    {
+        DynamicProgrammingBellmanArrayOneParameters parameters;
+        parameters.verbosity_level = 0;
+        parameters.checkpoint_path = checkpoint_path;
+        parameters.resume = true;
+        auto output = dynamic_programming_bellman_array_one(instance, parameters);
+        EXPECT_EQ(output.value, solution.profit());
+        EXPECT_EQ(output.value, output.solution.profit());
+    }
+
+    // Resume from the checkpoint written before the last item.
+    {
+        DynamicProgrammingBellmanArrayOneParameters parameters;
+        parameters.verbosity_level = 0;
+        parameters.checkpoint_path = checkpoint_path;
+        parameters.checkpoint_interval = 0;
+        dynamic_programming_bellman_array_one(instance, parameters);
+    }
+    {
+        DynamicProgrammingBellmanArrayOneParameters parameters;
+        parameters.verbosity_level = 0;
+        parameters.checkpoint_path = checkpoint_path;
+        parameters.resume = true;
+        auto output = dynamic_programming_bellman_array_one(instance, parameters);
+        EXPECT_EQ(output.value, solution.profit());
+        EXPECT_EQ(output.value, output.solution.profit());
+    }
+
+    std::remove(checkpoint_path.c_str());
+}
+
+INSTANTIATE_TEST_SUITE_P(
+        KnapsackDynamicProgrammingBellmanArrayOneCheckpoint,
+        DynamicProgrammingBellmanArrayOneCheckpointTest,
+        testing::ValuesIn(get_test_instance_paths()));
+
+TEST(DynamicProgrammingBellmanArrayOneCheckpoint, InvalidCheckpoint)
+{
+    InstanceBuilder instance_builder;
+    instance_builder.set_capacity(10);
+    instance_builder.add_item(7, 6);
+    instance_builder.add_item(5, 5);
+    instance_builder.add_item(5, 5);
+    const Instance instance = instance_builder.build();
+    std::string checkpoint_path = "dynamic_programming_bellman_array_one_test_invalid.checkpoint";
+    std::remove(checkpoint_path.c_str());
+    {
+        std::atomic<bool> stop(true);
+        DynamicProgrammingBellmanArrayOneParameters parameters;
+        parameters.verbosity_level = 0;
+        parameters.stop = &stop;
+        parameters.checkpoint_path = checkpoint_path;
+        dynamic_programming_bellman_array_one(instance, parameters);
+    }
+    DynamicProgrammingBellmanArrayOneParameters parameters;
+    parameters.verbosity_level = 0;
+    parameters.checkpoint_path = checkpoint_path;
+    parameters.resume = true;
+
+    // Same number of items, capacity, total profit and total weight, but
+    // different items.
+    InstanceBuilder instance_builder_other;
+    instance_builder_other.set_capacity(10);
+    instance_builder_other.add_item(5, 5);
+    instance_builder_other.add_item(7, 6);
+    instance_builder_other.add_item(5, 5);
+    const Instance instance_other = instance_builder_other.build();
+    EXPECT_THROW(
+            dynamic_programming_bellman_array_one(instance_other, parameters),
+            std::invalid_argument);
+
+    // Corrupt the size of the row of values, stored at the end of the file.
+    {
+        std::fstream file(checkpoint_path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(-(int64_t)((instance.capacity() + 1) * sizeof(Profit) + sizeof(int64_t)), std::ios::end);
+        int64_t size = (int64_t)1 << 60;
+        file.write(reinterpret_cast<const char*>(&size), sizeof(size));
+    }
+    EXPECT_THROW(
+            dynamic_programming_bellman_array_one(instance, parameters),
+            std::invalid_argument);
+    std::remove(checkpoint_path.c_str());
+}
+
+class DynamicProgrammingBellmanMemoryLimitTest: public testing::TestWithParam<TestInstancePath> { };
+
+TEST_P(DynamicProgrammingBellmanMemoryLimitTest, DynamicProgrammingBellmanMemoryLimit)
+{
+    TestInstancePath files = GetParam();
+    const Instance instance = get_instance(files);
+    Parameters parameters;
+    parameters.verbosity_level = 0;
+    parameters.memory_limit = 0;
+    EXPECT_THROW(
+            dynamic_programming_bellman_array(instance, parameters),
+            MemoryLimitExceeded);
+
+    // If all items fit, the algorithms falling back to the recursive scheme
+    // and the list algorithm don't allocate anything.
+    if (instance.total_item_weight() > instance.capacity()) {
+        EXPECT_THROW(
+                dynamic_programming_bellman_array_all(instance, parameters),
+                MemoryLimitExceeded);
+        DynamicProgrammingBellmanListParameters list_parameters;
+        list_parameters.verbosity_level = 0;
+        list_parameters.memory_limit = 0;
+        EXPECT_THROW(
+                dynamic_programming_bellman_list(instance, list_parameters),
+                MemoryLimitExceeded);
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+        KnapsackDynamicProgrammingBellmanMemoryLimit,
+        DynamicProgrammingBellmanMemoryLimitTest,
+        testing::ValuesIn(get_test_instance_paths()));
@@ -2,6 +2,8 @@
 
 #include "knapsacksolver/algorithms/dynamic_programming_primal_dual.hpp"
 
+#include "knapsacksolver/instance_builder.hpp"
+
 using namespace knapsacksolver;
 
 TEST_P(ExactAlgorithmTest, ExactAlgorithm)
@@ -389,3 +391,238 @@ INSTANTIATE_TEST_SUITE_P(
                     get_pisinger_instance_paths("hardinstances", "knapPI_16_50_1000"),
                     get_pisinger_instance_paths("hardinstances", "knapPI_16_100_1000"),
                 })));
+
+class DynamicProgrammingPrimalDualSessionTest: public testing::TestWithParam<TestInstancePath> { };
+
+TEST_P(DynamicProgrammingPrimalDualSessionTest, DynamicProgrammingPrimalDualSession)
+{
+    TestInstancePath files = GetParam();
+    const Instance instance = get_instance(files);
+    const Solution solution = get_solution(instance, files);
+
+    DynamicProgrammingPrimalDualSession session;
+    session.set_capacity(instance.capacity());
+    for (ItemId item_id = 0;
+            item_id < instance.number_of_items();
+            ++item_id) {
+        const Item& item = instance.item(item_id);
+        session.add_item(item.profit, item.weight);
+    }
+    DynamicProgrammingPrimalDualParameters parameters;
+    parameters.verbosity_level = 0;
+    auto output = session.solve(parameters);
+    EXPECT_EQ(output.value, solution.profit());
+    EXPECT_EQ(output.value, output.solution.profit());
+    EXPECT_EQ(output.bound, solution.profit());
+
+    // Modify the instance and solve it again.
+    for (ItemId item_id = 0;
+            item_id < instance.number_of_items();
+            item_id += 3) {
+        session.remove_item(item_id);
+    }
+    for (ItemId item_id = 1;
+            item_id < instance.number_of_items();
+            item_id += 3) {
+        const Item& item = instance.item(item_id);
+        session.set_item(item_id, item.profit + 1, item.weight);
+    }
+    session.set_capacity(instance.capacity() / 2);
+    auto output_session = session.solve(parameters);
+    auto output_scratch = dynamic_programming_primal_dual(
+            session.instance(),
+            parameters);
+    EXPECT_EQ(output_session.value, output_scratch.value);
+    EXPECT_EQ(output_session.value, output_session.solution.profit());
+    EXPECT_EQ(output_session.bound, output_scratch.value);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+        KnapsackDynamicProgrammingPrimalDualSession,
+        DynamicProgrammingPrimalDualSessionTest,
+        testing::ValuesIn(get_test_instance_paths()));
+
+class DynamicProgrammingPrimalDualWarmStartTest: public testing::TestWithParam<TestInstancePath> { };
+
+TEST_P(DynamicProgrammingPrimalDualWarmStartTest, DynamicProgrammingPrimalDualWarmStart)
+{
+    TestInstancePath files = GetParam();
+    const Instance instance = get_instance(files);
+    const Solution solution = get_solution(instance, files);
+
+    // Optimal initial solution.
+    {
+        DynamicProgrammingPrimalDualParameters parameters;
+        parameters.verbosity_level = 0;
+        parameters.initial_solution = &solution;
+        auto output = dynamic_programming_primal_dual(instance, parameters);
+        EXPECT_EQ(output.value, solution.profit());
+        EXPECT_EQ(output.value, output.solution.profit());
+        EXPECT_EQ(output.bound, solution.profit());
+    }
+
+    // Optimal lower bound.
+    {
+        DynamicProgrammingPrimalDualParameters parameters;
+        parameters.verbosity_level = 0;
+        parameters.lower_bound = solution.profit();
+        auto output = dynamic_programming_primal_dual(instance, parameters);
+        EXPECT_EQ(output.value, solution.profit());
+        EXPECT_EQ(output.bound, solution.profit());
+    }
+
+    // Non-optimal lower bound.
+    if (solution.profit() > 0) {
+        DynamicProgrammingPrimalDualParameters parameters;
+        parameters.verbosity_level = 0;
+        parameters.lower_bound = solution.profit() - 1;
+        auto output = dynamic_programming_primal_dual(instance, parameters);
+        EXPECT_EQ(output.value, solution.profit());
+        EXPECT_EQ(output.value, output.solution.profit());
+        EXPECT_EQ(output.bound, solution.profit());
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+        KnapsackDynamicProgrammingPrimalDualWarmStart,
+        DynamicProgrammingPrimalDualWarmStartTest,
+        testing::ValuesIn(get_test_instance_paths()));
+
+class DynamicProgrammingPrimalDualCheckpointTest: public testing::TestWithParam<TestInstancePath> { };
+
+TEST_P(DynamicProgrammingPrimalDualCheckpointTest, DynamicProgrammingPrimalDualCheckpoint)
+{
+    TestInstancePath files = GetParam();
+    const Instance instance = get_instance(files);
+    const Solution solution = get_solution(instance, files);
+    std::string checkpoint_path = "dynamic_programming_primal_dual_test.checkpoint";
+    std::remove(checkpoint_path.c_str());
+
+    // Interrupted before the first iteration.
+    {
+        std::atomic<bool> stop(true);
+        DynamicProgrammingPrimalDualParameters parameters;
+        parameters.verbosity_level = 0;
+        parameters.stop = &stop;
+        parameters.checkpoint_path = checkpoint_path;
+        dynamic_programming_primal_dual(instance, parameters);
+    }
+    {
+        DynamicProgrammingPrimalDualParameters parameters;
+        parameters.verbosity_level = 0;
+        parameters.checkpoint_path = checkpoint_path;
+        parameters.resume = true;
+        auto output = dynamic_programming_primal_dual(instance, parameters);
+        EXPECT_EQ(output.value, solution.profit());
+        EXPECT_EQ(output.value, output.solution.profit());
+        EXPECT_EQ(output.bound, solution.profit());
+    }
+
+    // Resume from the checkpoint written at the last iteration.
+    {
+        DynamicProgrammingPrimalDualParameters parameters;
+        parameters.verbosity_level = 0;
+        parameters.checkpoint_path = checkpoint_path;
+        parameters.checkpoint_interval = 0;
+        dynamic_programming_primal_dual(instance, parameters);
+    }
+    {
+        DynamicProgrammingPrimalDualParameters parameters;
+        parameters.verbosity_level = 0;
+        parameters.checkpoint_path = checkpoint_path;
+        parameters.resume = true;
+        auto output = dynamic_programming_primal_dual(instance, parameters);
+        EXPECT_EQ(output.value, solution.profit());
+        EXPECT_EQ(output.value, output.solution.profit());
+        EXPECT_EQ(output.bound, solution.profit());
+    }
+
+    std::remove(checkpoint_path.c_str());
+}
+
+INSTANTIATE_TEST_SUITE_P(
+        KnapsackDynamicProgrammingPrimalDualCheckpoint,
+        DynamicProgrammingPrimalDualCheckpointTest,
+        testing::ValuesIn(get_test_instance_paths()));
+
+TEST(DynamicProgrammingPrimalDual, MemoryLimit)
+{
+    // The greedy solution is not optimal, so the lists of states are built.
+    InstanceBuilder instance_builder;
+    instance_builder.set_capacity(10);
+    instance_builder.add_item(7, 6);
+    instance_builder.add_item(5, 5);
+    instance_builder.add_item(5, 5);
+    const Instance instance = instance_builder.build();
+
+    DynamicProgrammingPrimalDualParameters parameters;
+    parameters.verbosity_level = 0;
+    parameters.memory_limit = 0;
+    EXPECT_THROW(
+            dynamic_programming_primal_dual(instance, parameters),
+            MemoryLimitExceeded);
+
+    parameters.memory_limit = 1024 * 1024;
+    auto output = dynamic_programming_primal_dual(instance, parameters);
+    EXPECT_EQ(output.value, 10);
+    EXPECT_EQ(output.solution.profit(), 10);
+}
+
+TEST(DynamicProgrammingPrimalDual, Statistics)
+{
+    InstanceBuilder instance_builder;
+    instance_builder.set_capacity(10);
+    instance_builder.add_item(7, 6);
+    instance_builder.add_item(5, 5);
+    instance_builder.add_item(5, 5);
+    const Instance instance = instance_builder.build();
+
+    DynamicProgrammingPrimalDualParameters parameters;
+    parameters.verbosity_level = 0;
+    auto output = dynamic_programming_primal_dual(instance, parameters);
+    EXPECT_FALSE(output.statistics.enabled);
+    EXPECT_EQ(output.to_json().count("Statistics"), 0u);
+
+    parameters.statistics = true;
+    output = dynamic_programming_primal_dual(instance, parameters);
+    EXPECT_EQ(output.value, 10);
+    EXPECT_TRUE(output.statistics.enabled);
+    EXPECT_FALSE(output.statistics.state_list_sizes.empty());
+    EXPECT_GT(output.statistics.peak_memory, 0);
+    EXPECT_TRUE(std::any_of(
+                output.statistics.phase_times.begin(),
+                output.statistics.phase_times.end(),
+                [](const std::pair<std::string, double>& phase_time)
+                {
+                    return phase_time.first == "DynamicProgramming";
+                }));
+    EXPECT_EQ(output.to_json().count("Statistics"), 1u);
+}
+
+TEST(DynamicProgrammingPrimalDual, PerformanceCounters)
+{
+    InstanceBuilder instance_builder;
+    instance_builder.set_capacity(10);
+    instance_builder.add_item(7, 6);
+    instance_builder.add_item(5, 5);
+    instance_builder.add_item(5, 5);
+    const Instance instance = instance_builder.build();
+
+    // The counters might not be available, but the algorithm must run and
+    // the states must be counted anyway.
+    DynamicProgrammingPrimalDualParameters parameters;
+    parameters.verbosity_level = 0;
+    parameters.performance_counters = true;
+    auto output = dynamic_programming_primal_dual(instance, parameters);
+    EXPECT_EQ(output.value, 10);
+    EXPECT_TRUE(output.statistics.enabled);
+    EXPECT_GT(output.statistics.number_of_states_processed, 0);
+    nlohmann::json json = output.to_json()["Statistics"];
+    if (PerformanceCounters().available()) {
+        EXPECT_TRUE(output.statistics.performance_counters_enabled);
+        EXPECT_EQ(json.count("PerformanceCounters"), 1u);
+    } else {
+        EXPECT_FALSE(output.statistics.performance_counters_enabled);
+        EXPECT_EQ(json.count("PerformanceCounters"), 0u);
+    }
+}
@@ -0,0 +1,67 @@
+#include "knapsacksolver/tests.hpp"
+
+#include "knapsacksolver/algorithms/greedy.hpp"
+
+#include "knapsacksolver/instance_builder.hpp"
+
+using namespace knapsacksolver;
+
+namespace
+{
+
+/**
+ * Build an instance for which the greedy solutions only add or remove a
+ * single item, whereas filling the break solution with the items after the
+ * break item reaches the optimal value.
+ */
+const Instance build_instance()
+{
+    InstanceBuilder instance_builder;
+    instance_builder.set_capacity(10);
+    instance_builder.add_item(10, 5);
+    instance_builder.add_item(9, 6);
+    instance_builder.add_item(2, 2);
+    instance_builder.add_item(2, 2);
+    instance_builder.add_item(1, 1);
+    return instance_builder.build();
+}
+
+}
+
+TEST(Greedy, Greedy)
+{
+    const Instance instance = build_instance();
+    GreedyParameters parameters;
+    parameters.verbosity_level = 0;
+    auto output = greedy(instance, parameters);
+    EXPECT_EQ(output.value, 12);
+    EXPECT_EQ(output.solution.profit(), output.value);
+    EXPECT_TRUE(output.solution.feasible());
+}
+
+TEST(Greedy, Extended)
+{
+    const Instance instance = build_instance();
+    GreedyParameters parameters;
+    parameters.verbosity_level = 0;
+    parameters.extended = true;
+    auto output = greedy(instance, parameters);
+    EXPECT_EQ(output.value, 15);
+    EXPECT_EQ(output.solution.profit(), output.value);
+    EXPECT_TRUE(output.solution.feasible());
+}
+
+TEST(Greedy, ExtendedFullSort)
+{
+    const Instance instance = build_instance();
+    FullSort full_sort(instance);
+    GreedyParameters parameters;
+    parameters.verbosity_level = 0;
+    parameters.full_sort = &full_sort;
+    auto output = greedy(instance, parameters);
+    parameters.extended = true;
+    auto output_extended = greedy(instance, parameters);
+    EXPECT_LT(output.value, output_extended.value);
+    EXPECT_EQ(output_extended.value, 15);
+    EXPECT_TRUE(output_extended.solution.feasible());
+}
@@ -0,0 +1,57 @@
+#include "knapsacksolver/tests.hpp"
+
+#include "knapsacksolver/algorithms/portfolio.hpp"
+#include "knapsacksolver/algorithms/dynamic_programming_bellman.hpp"
+
+using namespace knapsacksolver;
+
+TEST_P(ExactAlgorithmTest, ExactAlgorithm)
+{
+    TestParams test_params = GetParam();
+    const Instance instance = get_instance(test_params.files);
+    const Solution solution = get_solution(instance, test_params.files);
+    auto output = test_params.algorithm(instance);
+    EXPECT_EQ(output.value, solution.profit());
+    EXPECT_EQ(output.value, output.solution.profit());
+    EXPECT_EQ(output.bound, solution.profit());
+}
+
+INSTANTIATE_TEST_SUITE_P(
+        KnapsackPortfolio,
+        ExactAlgorithmTest,
+        testing::ValuesIn(get_test_params(
+                {
+                    [](const Instance& instance)
+                    {
+                        PortfolioParameters parameters;
+                        parameters.verbosity_level = 0;
+                        return portfolio(instance, parameters);
+                    },
+                    [](const Instance& instance)
+                    {
+                        // The array algorithm only finds the optimal value,
+                        // the solution comes from the other algorithm.
+                        PortfolioParameters parameters;
+                        parameters.verbosity_level = 0;
+                        parameters.algorithms.push_back({
+                                "dynamic-programming-bellman-array",
+                                [](const Instance& instance, const Parameters& parameters)
+                                {
+                                    return dynamic_programming_bellman_array(
+                                            instance,
+                                            portfolio_algorithm_parameters<Parameters>(parameters));
+                                }});
+                        parameters.algorithms.push_back({
+                                "dynamic-programming-bellman-array-all",
+                                [](const Instance& instance, const Parameters& parameters)
+                                {
+                                    return dynamic_programming_bellman_array_all(
+                                            instance,
+                                            portfolio_algorithm_parameters<Parameters>(parameters));
+                                }});
+                        return portfolio(instance, parameters);
+                    },
+                },
+                {
+                    get_test_instance_paths(),
+                })));
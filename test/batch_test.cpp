@@ -0,0 +1,214 @@
+#include "knapsacksolver/tests.hpp"
+
+#include "knapsacksolver/batch.hpp"
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+
+using namespace knapsacksolver;
+
+TEST(Batch, Batch)
+{
+    std::vector<TestInstancePath> files = get_test_instance_paths();
+    std::vector<Instance> instances;
+    for (const TestInstancePath& f: files)
+        instances.push_back(get_instance(f));
+
+    BatchParameters parameters;
+    parameters.number_of_threads = 4;
+    auto output = solve_batch(instances, parameters);
+
+    ASSERT_EQ(output.outputs.size(), instances.size());
+    for (std::size_t instance_pos = 0;
+            instance_pos < instances.size();
+            ++instance_pos) {
+        const Solution solution = get_solution(instances[instance_pos], files[instance_pos]);
+        const Output& instance_output = output.outputs[instance_pos];
+        EXPECT_EQ(&instance_output.solution.instance(), &instances[instance_pos]);
+        EXPECT_EQ(instance_output.value, solution.profit());
+        EXPECT_EQ(instance_output.value, instance_output.solution.profit());
+        EXPECT_EQ(instance_output.bound, solution.profit());
+    }
+}
+
+TEST(Batch, Parameters)
+{
+    std::vector<TestInstancePath> files = get_test_instance_paths();
+    std::vector<Instance> instances;
+    for (const TestInstancePath& f: files)
+        instances.push_back(get_instance(f));
+
+    // The limits are given to the algorithm of each instance.
+    BatchParameters parameters;
+    parameters.number_of_threads = 2;
+    parameters.time_limit = 100;
+    parameters.memory_limit = 1024 * 1024 * 1024;
+    std::atomic<Counter> number_of_calls(0);
+    parameters.algorithm = [&number_of_calls](
+            const Instance& instance,
+            const Parameters& parameters)
+    {
+        EXPECT_EQ(parameters.memory_limit, 1024 * 1024 * 1024);
+        EXPECT_EQ(parameters.verbosity_level, 0);
+        number_of_calls++;
+        Output output(instance);
+        output.value = instance.number_of_items();
+        return output;
+    };
+    auto output = solve_batch(instances, parameters);
+    EXPECT_EQ(number_of_calls, (Counter)instances.size());
+    for (std::size_t instance_pos = 0;
+            instance_pos < instances.size();
+            ++instance_pos) {
+        EXPECT_EQ(output.outputs[instance_pos].value, instances[instance_pos].number_of_items());
+    }
+}
+
+TEST(Batch, ReadBatchManifest)
+{
+    std::vector<TestInstancePath> files = get_test_instance_paths();
+    std::string instance_path = get_path({
+            std::getenv("KNAPSACK_DATA"),
+            files[3].instance_path});
+    std::stringstream manifest;
+    manifest
+        << instance_path << std::endl
+        << std::endl
+        << "{\"Name\": \"inline\", \"Capacity\": 10, \"Profits\": [5, 6, 7], \"Weights\": [4, 5, 6]}" << std::endl
+        << "{\"Capacity\": 3, \"Profits\": [1], \"Weights\": [2]}" << std::endl;
+    std::vector<std::string> names;
+    std::vector<Instance> instances = read_batch_manifest(
+            manifest,
+            files[3].instance_format,
+            names);
+
+    ASSERT_EQ(instances.size(), 3u);
+    EXPECT_EQ(names, std::vector<std::string>({instance_path, "inline", "line 4"}));
+    EXPECT_EQ(instances[0].number_of_items(), get_instance(files[3]).number_of_items());
+    EXPECT_EQ(instances[1].number_of_items(), 3);
+    EXPECT_EQ(instances[1].capacity(), 10);
+    EXPECT_EQ(instances[1].item(2).profit, 7);
+    EXPECT_EQ(instances[1].item(2).weight, 6);
+    EXPECT_EQ(instances[2].number_of_items(), 1);
+
+    std::stringstream invalid_manifest("{\"Capacity\": 3}");
+    EXPECT_THROW(
+            read_batch_manifest(invalid_manifest, "standard", names),
+            std::invalid_argument);
+}
+
+TEST(Batch, SolveBatchManifest)
+{
+    std::vector<TestInstancePath> files = get_test_instance_paths();
+    std::stringstream manifest;
+    for (const TestInstancePath& f: files) {
+        manifest << get_path({
+                std::getenv("KNAPSACK_DATA"),
+                f.instance_path}) << std::endl;
+    }
+    manifest
+        << std::endl
+        << "{\"Capacity\": 3}" << std::endl
+        << "missing_instance.txt" << std::endl
+        << "{\"Name\": \"inline\", \"Capacity\": 10, \"Profits\": [5, 6, 7], \"Weights\": [4, 5, 6]}" << std::endl;
+
+    // The lines which can't be read are reported and the others are solved.
+    BatchParameters parameters;
+    parameters.number_of_threads = 3;
+    parameters.look_ahead = 2;
+    std::mutex mutex;
+    std::map<std::size_t, Profit> values;
+    std::vector<BatchEntry> errors;
+    parameters.new_output_callback = [&mutex, &values](
+            const BatchEntry& entry,
+            const Output& output)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        values[entry.position] = output.value;
+    };
+    parameters.error_callback = [&mutex, &errors](
+            const BatchEntry& entry,
+            const std::exception&)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        errors.push_back(entry);
+    };
+    auto output = solve_batch_manifest(
+            manifest,
+            files[0].instance_format,
+            parameters);
+
+    EXPECT_EQ(output.number_of_instances, (Counter)files.size() + 3);
+    EXPECT_EQ(output.number_of_errors, 2);
+    ASSERT_EQ(values.size(), files.size() + 1);
+    for (std::size_t instance_pos = 0;
+            instance_pos < files.size();
+            ++instance_pos) {
+        const Instance instance = get_instance(files[instance_pos]);
+        const Solution solution = get_solution(instance, files[instance_pos]);
+        EXPECT_EQ(values[instance_pos], solution.profit());
+    }
+    EXPECT_EQ(values[files.size() + 2], 12);
+    ASSERT_EQ(errors.size(), 2u);
+    std::sort(
+            errors.begin(),
+            errors.end(),
+            [](const BatchEntry& entry_1, const BatchEntry& entry_2)
+            {
+                return entry_1.position < entry_2.position;
+            });
+    EXPECT_EQ(errors[0].position, files.size());
+    EXPECT_EQ(errors[0].line_number, (Counter)files.size() + 2);
+    EXPECT_EQ(errors[1].name, "missing_instance.txt");
+    EXPECT_EQ(errors[1].line_number, (Counter)files.size() + 3);
+
+    // Without error callback, the error is rethrown.
+    std::stringstream invalid_manifest("{\"Capacity\": 3}");
+    EXPECT_THROW(
+            solve_batch_manifest(invalid_manifest, "standard", {}),
+            std::invalid_argument);
+}
+
+TEST(Batch, ErrorCallback)
+{
+    std::vector<TestInstancePath> files = get_test_instance_paths();
+    std::vector<Instance> instances;
+    for (const TestInstancePath& f: files)
+        instances.push_back(get_instance(f));
+
+    // An instance which can't be solved doesn't stop the others.
+    BatchParameters parameters;
+    parameters.number_of_threads = 2;
+    parameters.algorithm = [](
+            const Instance& instance,
+            const Parameters&)
+    {
+        if (instance.number_of_items() % 2 == 0)
+            throw MemoryLimitExceeded("test", 2, 1);
+        Output output(instance);
+        output.value = instance.number_of_items();
+        return output;
+    };
+    std::atomic<Counter> number_of_errors(0);
+    parameters.error_callback = [&number_of_errors](
+            const BatchEntry&,
+            const std::exception& e)
+    {
+        EXPECT_NE(dynamic_cast<const MemoryLimitExceeded*>(&e), nullptr);
+        number_of_errors++;
+    };
+    auto output = solve_batch(instances, parameters);
+    Counter number_of_even_instances = 0;
+    for (std::size_t instance_pos = 0;
+            instance_pos < instances.size();
+            ++instance_pos) {
+        if (instances[instance_pos].number_of_items() % 2 == 0) {
+            number_of_even_instances++;
+        } else {
+            EXPECT_EQ(output.outputs[instance_pos].value, instances[instance_pos].number_of_items());
+        }
+    }
+    EXPECT_EQ(number_of_errors, number_of_even_instances);
+    EXPECT_EQ(output.number_of_errors, number_of_even_instances);
+}
@@ -0,0 +1,90 @@
+#include "knapsacksolver/features.hpp"
+#include "knapsacksolver/generator.hpp"
+#include "knapsacksolver/instance_builder.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace knapsacksolver;
+
+TEST(FeaturesTest, Features)
+{
+    InstanceBuilder instance_builder;
+    instance_builder.set_capacity(12);
+    instance_builder.add_item(2, 4);
+    instance_builder.add_item(4, 8);
+    instance_builder.add_item(6, 12);
+    instance_builder.add_item(10, 6);
+    const Instance instance = instance_builder.build();
+
+    InstanceFeatures features = compute_features(instance);
+    EXPECT_EQ(features.number_of_items, 4);
+    EXPECT_EQ(features.capacity, 12);
+    EXPECT_DOUBLE_EQ(features.capacity_ratio, 12.0 / 30);
+    EXPECT_EQ(features.minimum_weight, 4);
+    EXPECT_EQ(features.maximum_weight, 12);
+    EXPECT_EQ(features.minimum_profit, 2);
+    EXPECT_EQ(features.maximum_profit, 10);
+    EXPECT_FALSE(features.subset_sum);
+    EXPECT_EQ(features.weight_gcd, 2);
+    // Items 0, 1 and 2 have the same efficiency as the break item.
+    EXPECT_EQ(features.estimated_core_size, 3);
+}
+
+TEST(FeaturesTest, SelectAlgorithm)
+{
+    Generator generator;
+    generator.n = 100;
+    generator.r = 1000000;
+
+    generator.t = "ss";
+    InstanceFeatures features_ss = compute_features(generator.generate());
+    EXPECT_TRUE(features_ss.subset_sum);
+    EXPECT_DOUBLE_EQ(features_ss.weight_profit_correlation, 1.0);
+    EXPECT_TRUE(select_algorithm(features_ss).pairing);
+
+    generator.t = "u";
+    InstanceFeatures features_u = compute_features(generator.generate());
+    EXPECT_FALSE(features_u.subset_sum);
+    EXPECT_LT(features_u.weight_profit_correlation, 0.5);
+    AlgorithmSelection selection_u = select_algorithm(features_u);
+    EXPECT_EQ(selection_u.algorithm, "dynamic-programming-primal-dual");
+    EXPECT_FALSE(selection_u.pairing);
+}
+
+TEST(FeaturesTest, SelectAlgorithmEngines)
+{
+    Generator generator;
+    generator.n = 100;
+    generator.r = 10;
+    generator.t = "ss";
+
+    // All the items fit.
+    generator.x = 1.0;
+    AlgorithmSelection selection_fit = select_algorithm(
+            compute_features(generator.generate()));
+    EXPECT_EQ(selection_fit.algorithm, "greedy");
+
+    // Small subset sum instance.
+    generator.x = 0.5;
+    const Instance instance = generator.generate();
+    InstanceFeatures features = compute_features(instance);
+    ASSERT_EQ(features.weight_gcd, 1);
+    AlgorithmSelection selection_small = select_algorithm(features);
+    EXPECT_EQ(selection_small.algorithm, "dynamic-programming-bellman-array-rec");
+    EXPECT_EQ(selection_small.features.number_of_items, 100);
+
+    // Same instance with all the weights multiplied by 2: the states of the
+    // primal-dual algorithm only have even weights.
+    InstanceBuilder instance_builder;
+    instance_builder.set_capacity(2 * instance.capacity());
+    for (ItemId item_id = 0;
+            item_id < instance.number_of_items();
+            ++item_id) {
+        const Item& item = instance.item(item_id);
+        instance_builder.add_item(item.profit, 2 * item.weight);
+    }
+    InstanceFeatures features_gcd = compute_features(instance_builder.build());
+    EXPECT_EQ(features_gcd.weight_gcd, 2);
+    AlgorithmSelection selection_gcd = select_algorithm(features_gcd);
+    EXPECT_EQ(selection_gcd.algorithm, "dynamic-programming-primal-dual");
+}
@@ -0,0 +1,118 @@
+#include "knapsacksolver/generator.hpp"
+
+#include "knapsacksolver/algorithms/dynamic_programming_bellman.hpp"
+#include "knapsacksolver/algorithms/dynamic_programming_primal_dual.hpp"
+
+#include <gtest/gtest.h>
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+#include <sstream>
+
+using namespace knapsacksolver;
+
+class GeneratorTest: public testing::TestWithParam<std::string> { };
+
+TEST_P(GeneratorTest, Generator)
+{
+    for (int variant = 0; variant < 3; ++variant) {
+        Generator generator;
+        generator.t = GetParam();
+        generator.n = 50;
+        generator.r = 100;
+        generator.h = 50;
+        generator.s = 7;
+        generator.spanner = (variant == 1);
+        generator.normal = (variant == 2);
+        const Instance instance = generator.generate();
+        ASSERT_EQ(instance.number_of_items(), generator.n);
+
+        // The instance only depends on the attributes of the generator.
+        const Instance instance_2 = generator.generate();
+        EXPECT_EQ(instance_2.capacity(), instance.capacity());
+        for (ItemId item_id = 0;
+                item_id < instance.number_of_items();
+                ++item_id) {
+            EXPECT_EQ(instance_2.item(item_id).profit, instance.item(item_id).profit);
+            EXPECT_EQ(instance_2.item(item_id).weight, instance.item(item_id).weight);
+        }
+
+        Parameters parameters;
+        parameters.verbosity_level = 0;
+        auto output_bellman = dynamic_programming_bellman_array(instance, parameters);
+        DynamicProgrammingPrimalDualParameters primal_dual_parameters;
+        primal_dual_parameters.verbosity_level = 0;
+        auto output_primal_dual = dynamic_programming_primal_dual(instance, primal_dual_parameters);
+        EXPECT_EQ(output_primal_dual.value, output_bellman.value);
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+        KnapsackGenerator,
+        GeneratorTest,
+        testing::Values("u", "wc", "sc", "isc", "asc", "ss", "sw", "mstr", "pceil", "circle"));
+
+TEST(Generator, UnknownType)
+{
+    Generator generator;
+    generator.t = "unknown";
+    EXPECT_THROW(generator.generate(), std::invalid_argument);
+}
+
+namespace
+{
+
+std::string read_file(const boost::filesystem::path& path)
+{
+    std::ifstream file(path.string(), std::ios::binary);
+    std::stringstream content;
+    content << file.rdbuf();
+    return content.str();
+}
+
+}
+
+TEST(Generator, GenerateInstancesNumberOfThreads)
+{
+    // The instances written only depend on the generator, not on the number
+    // of threads.
+    Generator generator;
+    generator.t = "sc";
+    generator.n = 100;
+    generator.r = 1000;
+    generator.s = 3;
+    Counter number_of_instances = 16;
+
+    for (std::string format: {"standard", "binary"}) {
+        boost::filesystem::path directory_1
+            = boost::filesystem::temp_directory_path()
+            / boost::filesystem::unique_path();
+        boost::filesystem::path directory_4
+            = boost::filesystem::temp_directory_path()
+            / boost::filesystem::unique_path();
+        boost::filesystem::create_directory(directory_1);
+        boost::filesystem::create_directory(directory_4);
+
+        generate_instances(generator, number_of_instances, directory_1.string(), format, 1);
+        generate_instances(generator, number_of_instances, directory_4.string(), format, 4);
+
+        std::vector<std::string> file_names;
+        for (const auto& entry: boost::filesystem::directory_iterator(directory_1))
+            file_names.push_back(entry.path().filename().string());
+        EXPECT_EQ((Counter)file_names.size(), number_of_instances);
+        for (const std::string& file_name: file_names) {
+            ASSERT_TRUE(boost::filesystem::exists(directory_4 / file_name));
+            EXPECT_EQ(
+                    read_file(directory_4 / file_name),
+                    read_file(directory_1 / file_name));
+        }
+        EXPECT_EQ(
+                std::distance(
+                    boost::filesystem::directory_iterator(directory_4),
+                    boost::filesystem::directory_iterator()),
+                number_of_instances);
+
+        boost::filesystem::remove_all(directory_1);
+        boost::filesystem::remove_all(directory_4);
+    }
+}
@@ -0,0 +1,105 @@
+#include "knapsacksolver/tests.hpp"
+
+#include "knapsacksolver/instance_builder.hpp"
+
+#include <cstdio>
+#include <fstream>
+
+using namespace knapsacksolver;
+
+TEST(InstanceBuilderTest, BinaryRoundTrip)
+{
+    const Instance instance = build_test_instance(100);
+    std::string instance_path = "instance_builder_test_round_trip.bin";
+    instance.write_binary(instance_path);
+
+    InstanceBuilder instance_builder;
+    instance_builder.read(instance_path, "binary");
+    const Instance instance_read = instance_builder.build();
+    std::remove(instance_path.c_str());
+
+    EXPECT_EQ(instance_read.number_of_items(), instance.number_of_items());
+    EXPECT_EQ(instance_read.capacity(), instance.capacity());
+    EXPECT_EQ(instance_read.total_item_profit(), instance.total_item_profit());
+    EXPECT_EQ(instance_read.total_item_weight(), instance.total_item_weight());
+    for (ItemId item_id = 0; item_id < instance.number_of_items(); ++item_id) {
+        EXPECT_EQ(instance_read.item(item_id).profit, instance.item(item_id).profit);
+        EXPECT_EQ(instance_read.item(item_id).weight, instance.item(item_id).weight);
+    }
+}
+
+TEST(InstanceBuilderTest, BinaryCorrupted)
+{
+    const Instance instance = build_test_instance(100);
+    std::string instance_path = "instance_builder_test_corrupted.bin";
+    instance.write_binary(instance_path);
+
+    // Change the weight of the first item.
+    {
+        std::fstream file(instance_path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(sizeof(InstanceBinaryHeader) + instance.number_of_items() * sizeof(int64_t));
+        int64_t weight = 2;
+        file.write(reinterpret_cast<const char*>(&weight), sizeof(weight));
+    }
+
+    InstanceBuilder instance_builder;
+    EXPECT_THROW(
+            instance_builder.read(instance_path, "binary"),
+            std::invalid_argument);
+    std::remove(instance_path.c_str());
+}
+
+namespace
+{
+
+void write_file(
+        const std::string& path,
+        const std::string& content)
+{
+    std::ofstream file(path);
+    file << content;
+}
+
+}
+
+TEST(InstanceBuilderTest, StandardIntegerOverflow)
+{
+    std::string instance_path = "instance_builder_test_overflow.txt";
+
+    write_file(instance_path, "1 9223372036854775807\n5 4\n");
+    {
+        InstanceBuilder instance_builder;
+        EXPECT_NO_THROW(instance_builder.read(instance_path, "standard"));
+    }
+
+    write_file(instance_path, "1 9223372036854775808\n5 4\n");
+    {
+        InstanceBuilder instance_builder;
+        EXPECT_THROW(
+                instance_builder.read(instance_path, "standard"),
+                std::invalid_argument);
+    }
+
+    write_file(instance_path, "1 10\n100000000000000000000 4\n");
+    {
+        InstanceBuilder instance_builder;
+        EXPECT_THROW(
+                instance_builder.read(instance_path, "standard"),
+                std::invalid_argument);
+    }
+
+    std::remove(instance_path.c_str());
+}
+
+TEST(InstanceBuilderTest, StandardWrongNumberOfItems)
+{
+    // The number of items announced is only trusted up to the size of the
+    // file.
+    std::string instance_path = "instance_builder_test_number_of_items.txt";
+    write_file(instance_path, "1000000000000000000 10\n5 4\n");
+    InstanceBuilder instance_builder;
+    EXPECT_THROW(
+            instance_builder.read(instance_path, "standard"),
+            std::invalid_argument);
+    std::remove(instance_path.c_str());
+}
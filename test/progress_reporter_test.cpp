@@ -0,0 +1,103 @@
+#include "knapsacksolver/tests.hpp"
+
+#include "knapsacksolver/progress_reporter.hpp"
+#include "knapsacksolver/algorithms/dynamic_programming_bellman.hpp"
+
+#include "knapsacksolver/instance_builder.hpp"
+
+using namespace knapsacksolver;
+
+class ProgressReporterTest: public testing::TestWithParam<TestInstancePath> { };
+
+TEST_P(ProgressReporterTest, ProgressReporter)
+{
+    TestInstancePath files = GetParam();
+    const Instance instance = get_instance(files);
+    const Solution solution = get_solution(instance, files);
+
+    std::vector<ProgressSnapshot> snapshots;
+    ProgressReporter progress_reporter(
+            [&snapshots](const ProgressSnapshot& snapshot)
+            {
+                snapshots.push_back(snapshot);
+            });
+    Parameters parameters;
+    parameters.verbosity_level = 0;
+    parameters.new_solution_callback = progress_reporter.new_solution_callback();
+    auto output = dynamic_programming_bellman_array_all(instance, parameters);
+    progress_reporter.stop();
+
+        EXPECT_EQ(progress_reporter.number_of_reports(), (Counter)snapshots.size());
+    // Nothing is reported if the output is never updated.
+    if (snapshots.empty())
+        return;
+    EXPECT_EQ(snapshots.back().value, solution.profit());
+    EXPECT_EQ(snapshots.back().bound, solution.profit());
+    for (std::size_t pos = 1; pos < snapshots.size(); ++pos) {
+        EXPECT_GE(snapshots[pos].value, snapshots[pos - 1].value);
+        EXPECT_LE(snapshots[pos].bound, snapshots[pos - 1].bound);
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+        KnapsackProgressReporter,
+        ProgressReporterTest,
+        testing::ValuesIn(get_test_instance_paths()));
+
+TEST(ProgressReporter, OverwrittenSnapshots)
+{
+    InstanceBuilder instance_builder;
+    instance_builder.set_capacity(10);
+    instance_builder.add_item(1, 1);
+    const Instance instance = instance_builder.build();
+
+    // The reporting thread doesn't consume anything before being stopped, so
+    // each snapshot replaces the previous one, and only the last one is
+    // reported.
+    std::vector<ProgressSnapshot> snapshots;
+    ProgressReporter progress_reporter(
+            [&snapshots](const ProgressSnapshot& snapshot)
+            {
+                snapshots.push_back(snapshot);
+            },
+            3600);
+    Output output(instance);
+    for (Counter i = 0; i < 10; ++i) {
+        output.value = i;
+        progress_reporter.publish(output);
+    }
+    progress_reporter.stop();
+    EXPECT_EQ(progress_reporter.number_of_overwritten_snapshots(), 9);
+    ASSERT_EQ(snapshots.size(), 1u);
+    EXPECT_EQ(snapshots.back().value, 9);
+}
+
+TEST(ProgressReporter, Concurrent)
+{
+    InstanceBuilder instance_builder;
+    instance_builder.set_capacity(10);
+    instance_builder.add_item(1, 1);
+    const Instance instance = instance_builder.build();
+
+    // The values reported are increasing and the last one is always
+    // reported.
+    std::vector<ProgressSnapshot> snapshots;
+    ProgressReporter progress_reporter(
+            [&snapshots](const ProgressSnapshot& snapshot)
+            {
+                snapshots.push_back(snapshot);
+            });
+    Output output(instance);
+    for (Counter i = 0; i < 100000; ++i) {
+        output.value = i;
+        progress_reporter.publish(output);
+    }
+    progress_reporter.stop();
+    ASSERT_FALSE(snapshots.empty());
+    EXPECT_EQ(snapshots.back().value, 99999);
+    for (std::size_t pos = 1; pos < snapshots.size(); ++pos)
+        EXPECT_GT(snapshots[pos].value, snapshots[pos - 1].value);
+    EXPECT_EQ(
+            progress_reporter.number_of_overwritten_snapshots() + (Counter)snapshots.size(),
+            100000);
+}
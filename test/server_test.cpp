@@ -0,0 +1,174 @@
+#include "knapsacksolver/tests.hpp"
+
+#include "knapsacksolver/server.hpp"
+#include "knapsacksolver/instance_builder.hpp"
+
+#include <thread>
+
+#include <unistd.h>
+
+using namespace knapsacksolver;
+
+TEST(Server, Server)
+{
+    std::vector<TestInstancePath> files = get_test_instance_paths();
+    std::vector<Instance> instances;
+    for (const TestInstancePath& f: files)
+        instances.push_back(get_instance(f));
+
+    std::atomic<bool> stop(false);
+    ServerParameters parameters;
+    parameters.socket_path = "knapsacksolver_server_test_" + std::to_string(getpid()) + ".sock";
+    parameters.number_of_threads = 2;
+    parameters.stop = &stop;
+    ServerOutput output;
+    std::thread server([&parameters, &output]() { output = serve(parameters); });
+
+    // Wait for the server to listen.
+    std::unique_ptr<ServerClient> client;
+    for (int attempt = 0; client == nullptr; ++attempt) {
+        try {
+            client.reset(new ServerClient(parameters.socket_path));
+        } catch (const std::runtime_error&) {
+            if (attempt == 100)
+                throw;
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    }
+
+    // Solve all the instances twice on the same connection.
+    for (int round = 0; round < 2; ++round) {
+        for (std::size_t instance_pos = 0;
+                instance_pos < instances.size();
+                ++instance_pos) {
+            const Instance& instance = instances[instance_pos];
+            const Solution solution = get_solution(instance, files[instance_pos]);
+            Counter number_of_new_solutions = 0;
+            Profit previous_solution_value = -1;
+            auto response = client->solve(
+                    instance,
+                    -1,
+                    [&number_of_new_solutions, &previous_solution_value](
+                        const ServerResponse& response)
+                    {
+                        // Only new solutions are sent.
+                        EXPECT_GT(response.solution.profit(), previous_solution_value);
+                        previous_solution_value = response.solution.profit();
+                        number_of_new_solutions++;
+                    });
+            EXPECT_EQ(response.value, solution.profit());
+            EXPECT_EQ(response.solution.profit(), solution.profit());
+            EXPECT_TRUE(response.solution.feasible());
+            EXPECT_EQ(response.bound, solution.profit());
+            if (instance.number_of_items() > 0) {
+                EXPECT_GE(number_of_new_solutions, 1);
+            }
+        }
+    }
+    client.reset();
+
+    stop = true;
+    server.join();
+    EXPECT_EQ(output.number_of_connections, 1);
+    EXPECT_EQ(output.number_of_requests, 2 * (Counter)instances.size());
+}
+
+TEST(Server, TooManyItems)
+{
+    InstanceBuilder instance_builder;
+    instance_builder.set_capacity(4);
+    instance_builder.add_item(2, 3);
+    instance_builder.add_item(3, 3);
+    instance_builder.add_item(4, 3);
+    const Instance instance = instance_builder.build();
+
+    InstanceBuilder instance_builder_small;
+    instance_builder_small.set_capacity(4);
+    instance_builder_small.add_item(2, 3);
+    instance_builder_small.add_item(3, 3);
+    const Instance instance_small = instance_builder_small.build();
+
+    std::atomic<bool> stop(false);
+    ServerParameters parameters;
+    parameters.socket_path = "knapsacksolver_server_test_too_many_items_" + std::to_string(getpid()) + ".sock";
+    parameters.maximum_number_of_items = 2;
+    parameters.stop = &stop;
+    std::thread server([&parameters]() { serve(parameters); });
+
+    std::unique_ptr<ServerClient> client;
+    for (int attempt = 0; client == nullptr; ++attempt) {
+        try {
+            client.reset(new ServerClient(parameters.socket_path));
+        } catch (const std::runtime_error&) {
+            if (attempt == 100)
+                throw;
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    }
+    EXPECT_THROW(client->solve(instance, -1), std::runtime_error);
+
+    // The server still answers the requests of the other connections.
+    client.reset(new ServerClient(parameters.socket_path));
+    EXPECT_EQ(client->solve(instance_small, -1).value, 3);
+    client.reset();
+
+    stop = true;
+    server.join();
+}
+
+TEST(Server, MemoryLimit)
+{
+    InstanceBuilder instance_builder;
+    instance_builder.set_capacity(4);
+    instance_builder.add_item(2, 3);
+    instance_builder.add_item(3, 3);
+    const Instance instance = instance_builder.build();
+
+    // The memory limit is given to the algorithm, and a request exceeding it
+    // is answered with an error without closing the connection.
+    std::atomic<bool> stop(false);
+    std::atomic<bool> exceed(true);
+    ServerParameters parameters;
+    parameters.socket_path = "knapsacksolver_server_test_memory_limit_" + std::to_string(getpid()) + ".sock";
+    parameters.memory_limit = 1024 * 1024;
+    parameters.stop = &stop;
+    parameters.algorithm = [&exceed](
+            const Instance& instance,
+            const Parameters& parameters)
+    {
+        EXPECT_EQ(parameters.memory_limit, 1024 * 1024);
+        if (exceed)
+            throw MemoryLimitExceeded("test", 2.0 * parameters.memory_limit, parameters.memory_limit);
+        Output output(instance);
+        Solution solution(instance);
+        solution.add(1);
+        output.solution = solution;
+        output.value = solution.profit();
+        output.bound = solution.profit();
+        return output;
+    };
+    std::thread server([&parameters]() { serve(parameters); });
+
+    std::unique_ptr<ServerClient> client;
+    for (int attempt = 0; client == nullptr; ++attempt) {
+        try {
+            client.reset(new ServerClient(parameters.socket_path));
+        } catch (const std::runtime_error&) {
+            if (attempt == 100)
+                throw;
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    }
+    try {
+        client->solve(instance, -1);
+        ADD_FAILURE() << "The memory limit error hasn't been reported.";
+    } catch (const std::runtime_error& e) {
+        EXPECT_NE(std::string(e.what()).find("memory limit"), std::string::npos);
+    }
+    exceed = false;
+    EXPECT_EQ(client->solve(instance, -1).value, 3);
+    client.reset();
+
+    stop = true;
+    server.join();
+}
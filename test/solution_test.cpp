@@ -0,0 +1,66 @@
+#include "knapsacksolver/tests.hpp"
+
+#include "knapsacksolver/solution.hpp"
+#include "knapsacksolver/instance_builder.hpp"
+
+#include <cstdio>
+
+using namespace knapsacksolver;
+
+TEST(SolutionTest, Bitset)
+{
+    const Instance instance = build_test_instance(130);
+    Solution solution(instance);
+    for (ItemId item_id: {0, 63, 64, 127, 129})
+        solution.add(item_id);
+    EXPECT_EQ(solution.number_of_items(), 5);
+    EXPECT_EQ(solution.profit(), 1 + 64 + 65 + 128 + 130);
+    for (ItemId item_id = 0; item_id < instance.number_of_items(); ++item_id) {
+        bool contained = (item_id == 0 || item_id == 63 || item_id == 64
+                || item_id == 127 || item_id == 129);
+        EXPECT_EQ((bool)solution.contains(item_id), contained);
+    }
+
+    Solution solution_2 = solution;
+    solution_2.remove(64);
+    solution_2.add(65);
+    EXPECT_EQ(solution.distance(solution_2), 2);
+    EXPECT_EQ(solution_2.distance(solution_2), 0);
+
+    Solution solution_full(instance);
+    solution_full.fill();
+    EXPECT_EQ(solution_full.number_of_items(), instance.number_of_items());
+    EXPECT_EQ(solution_full.weight(), instance.total_item_weight());
+    EXPECT_EQ(solution_full.profit(), instance.total_item_profit());
+    EXPECT_EQ(solution_full.distance(solution), instance.number_of_items() - 5);
+}
+
+TEST(SolutionTest, WriteRead)
+{
+    const Instance instance = build_test_instance(130);
+    Solution solution(instance);
+    for (ItemId item_id = 0; item_id < instance.number_of_items(); item_id += 3)
+        solution.add(item_id);
+
+    std::string standard_path = "knapsacksolver_solution_test.txt";
+    solution.write(standard_path);
+    Solution solution_standard(instance, standard_path, "standard");
+    std::remove(standard_path.c_str());
+    EXPECT_EQ(solution_standard.distance(solution), 0);
+    EXPECT_EQ(solution_standard.profit(), solution.profit());
+
+    std::string binary_path = "knapsacksolver_solution_test.bin";
+    solution.write_binary(binary_path);
+    Solution solution_binary(instance, binary_path, "binary");
+    EXPECT_EQ(solution_binary.distance(solution), 0);
+    EXPECT_EQ(solution_binary.number_of_items(), solution.number_of_items());
+    EXPECT_EQ(solution_binary.weight(), solution.weight());
+    EXPECT_EQ(solution_binary.profit(), solution.profit());
+
+    // A certificate of another instance is rejected.
+    const Instance instance_2 = build_test_instance(129);
+    EXPECT_THROW(
+            Solution(instance_2, binary_path, "binary"),
+            std::invalid_argument);
+    std::remove(binary_path.c_str());
+}